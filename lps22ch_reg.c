@@ -108,6 +108,41 @@ float_t lps22ch_from_lsb_to_celsius(int16_t lsb)
   return ((float_t) lsb / 100.0f);
 }
 
+/* REF_P / THS_P resolution is the one of PRESS_OUT_H:L (16 LSB/hPa) */
+int16_t lps22ch_from_hpa_to_ref(float_t hpa)
+{
+  float_t lsb = hpa * 16.0f;
+
+  if (lsb > 32767.0f)
+  {
+    return 32767;
+  }
+
+  if (lsb < -32768.0f)
+  {
+    return -32768;
+  }
+
+  return (int16_t)((lsb < 0.0f) ? (lsb - 0.5f) : (lsb + 0.5f));
+}
+
+uint16_t lps22ch_from_hpa_to_ths(float_t hpa)
+{
+  float_t lsb = hpa * 16.0f;
+
+  if (lsb > 32767.0f)
+  {
+    return 0x7FFFU;
+  }
+
+  if (lsb < 0.0f)
+  {
+    return 0U;
+  }
+
+  return (uint16_t)(lsb + 0.5f);
+}
+
 /**
   * @}
   *
@@ -131,15 +166,15 @@ float_t lps22ch_from_lsb_to_celsius(int16_t lsb)
   */
 int32_t lps22ch_autozero_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.reset_az = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_AZ, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -155,14 +190,14 @@ int32_t lps22ch_autozero_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_autozero_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.reset_az;
+  *val = LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, RESET_AZ);
 
   return ret;
 }
@@ -177,15 +212,15 @@ int32_t lps22ch_autozero_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_autozero_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.autozero = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, AUTOZERO, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -201,14 +236,14 @@ int32_t lps22ch_autozero_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_autozero_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.autozero;
+  *val = LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, AUTOZERO);
 
   return ret;
 }
@@ -223,15 +258,15 @@ int32_t lps22ch_autozero_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_pressure_snap_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.reset_arp = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_ARP, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -247,14 +282,14 @@ int32_t lps22ch_pressure_snap_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_pressure_snap_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.reset_arp;
+  *val = LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, RESET_ARP);
 
   return ret;
 }
@@ -269,15 +304,15 @@ int32_t lps22ch_pressure_snap_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_pressure_snap_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.autorefp = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, AUTOREFP, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -293,14 +328,14 @@ int32_t lps22ch_pressure_snap_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_pressure_snap_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.autorefp;
+  *val = LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, AUTOREFP);
 
   return ret;
 }
@@ -315,15 +350,15 @@ int32_t lps22ch_pressure_snap_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret == 0)
   {
-    reg.bdu = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG1, BDU, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
   }
 
   return ret;
@@ -339,14 +374,14 @@ int32_t lps22ch_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.bdu;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG1, BDU);
 
   return ret;
 }
@@ -361,24 +396,27 @@ int32_t lps22ch_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_data_rate_set(const stmdev_ctx_t *ctx, lps22ch_odr_t val)
 {
-  lps22ch_ctrl_reg1_t ctrl_reg1;
-  lps22ch_ctrl_reg2_t ctrl_reg2;
+  uint8_t ctrl_reg1;
+  uint8_t ctrl_reg2;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-  ret += lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &ctrl_reg1, 1);
+  ret += lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &ctrl_reg2, 1);
 
   if (ret == 0)
   {
-    ctrl_reg1.odr = (uint8_t)val & 0x07U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+    ctrl_reg1 = LPS22CH_FIELD_SET(ctrl_reg1, CTRL_REG1, ODR,
+                                  (uint8_t)val & 0x07U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, &ctrl_reg1, 1);
   }
 
   if (ret == 0)
   {
-    ctrl_reg2.low_noise_en = ((uint8_t)val & 0x10U) >> 4;
-    ctrl_reg2.one_shot = ((uint8_t)val & 0x08U) >> 3;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    ctrl_reg2 = LPS22CH_FIELD_SET(ctrl_reg2, CTRL_REG2, LOW_NOISE_EN,
+                                  ((uint8_t)val & 0x10U) >> 4);
+    ctrl_reg2 = LPS22CH_FIELD_SET(ctrl_reg2, CTRL_REG2, ONE_SHOT,
+                                  ((uint8_t)val & 0x08U) >> 3);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &ctrl_reg2, 1);
   }
 
   return ret;
@@ -394,17 +432,18 @@ int32_t lps22ch_data_rate_set(const stmdev_ctx_t *ctx, lps22ch_odr_t val)
   */
 int32_t lps22ch_data_rate_get(const stmdev_ctx_t *ctx, lps22ch_odr_t *val)
 {
-  lps22ch_ctrl_reg1_t ctrl_reg1;
-  lps22ch_ctrl_reg2_t ctrl_reg2;
+  uint8_t ctrl_reg1;
+  uint8_t ctrl_reg2;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-  ret += lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &ctrl_reg1, 1);
+  ret += lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &ctrl_reg2, 1);
 
   if (ret == 0)
   {
-    switch (((ctrl_reg2.low_noise_en << 4) + (ctrl_reg2.one_shot << 3) +
-             ctrl_reg1.odr))
+    switch ((LPS22CH_FIELD_GET(ctrl_reg2, CTRL_REG2, LOW_NOISE_EN) << 4) +
+            (LPS22CH_FIELD_GET(ctrl_reg2, CTRL_REG2, ONE_SHOT) << 3) +
+            LPS22CH_FIELD_GET(ctrl_reg1, CTRL_REG1, ODR))
     {
       case 0x00:
         *val = LPS22CH_POWER_DOWN;
@@ -625,14 +664,14 @@ int32_t lps22ch_status_reg_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_press_flag_data_ready_get(const stmdev_ctx_t *ctx,
                                           uint8_t *val)
 {
-  lps22ch_status_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_STATUS, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_STATUS, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.p_da;
+  *val = LPS22CH_FIELD_GET(reg, STATUS, P_DA);
 
   return ret;
 }
@@ -648,14 +687,14 @@ int32_t lps22ch_press_flag_data_ready_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_temp_flag_data_ready_get(const stmdev_ctx_t *ctx,
                                          uint8_t *val)
 {
-  lps22ch_status_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_STATUS, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_STATUS, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.t_da;
+  *val = LPS22CH_FIELD_GET(reg, STATUS, T_DA);
 
   return ret;
 }
@@ -768,6 +807,199 @@ int32_t lps22ch_fifo_temperature_raw_get(const stmdev_ctx_t *ctx,
   return ret;
 }
 
+/**
+  * @brief  Status, pressure and temperature output values read
+  *         with a single transaction (STATUS..TEMP_OUT_H).[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      status register and raw output values
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_data_get(const stmdev_ctx_t *ctx, lps22ch_data_t *val)
+{
+  lps22ch_xfer_t xfer;
+  uint8_t buff[6];
+  int32_t ret;
+
+  lps22ch_xfer_data_prepare(&xfer, buff);
+  ret = lps22ch_xfer_exec(ctx, &xfer);
+
+  if (ret != 0) { return ret; }
+
+  lps22ch_xfer_data_decode(&xfer, val);
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure (and temperature) output values read with the
+  *         minimum register window for the selected resolution.
+  *         With 16-bit resolution PRESS_OUT_XL is skipped (1/16 hPa),
+  *         the pressure keeps the format of lps22ch_pressure_raw_get
+  *         with the lower bits cleared.
+  *         FIFO records are always popped as a whole, use
+  *         lps22ch_fifo_record_get for them.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  res      resolution / output selection
+  * @param  press    pressure output value
+  * @param  temp     temperature output value (used with *_TEMP only)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_data_res_get(const stmdev_ctx_t *ctx, lps22ch_res_t res,
+                             uint32_t *press, int16_t *temp)
+{
+  uint8_t buff[5] = { 0U };
+  uint8_t *p = buff;
+  uint16_t len;
+  uint8_t reg;
+  int32_t ret;
+
+  switch (res)
+  {
+    case LPS22CH_RES_PRESS_16BIT:
+      reg = LPS22CH_PRESS_OUT_L;
+      len = 2U;
+      break;
+
+    case LPS22CH_RES_PRESS_24BIT_TEMP:
+      reg = LPS22CH_PRESS_OUT_XL;
+      len = 5U;
+      break;
+
+    case LPS22CH_RES_PRESS_16BIT_TEMP:
+      reg = LPS22CH_PRESS_OUT_L;
+      len = 4U;
+      break;
+
+    default:
+      reg = LPS22CH_PRESS_OUT_XL;
+      len = 3U;
+      break;
+  }
+
+  /* buff is laid out as PRESS_OUT_XL..TEMP_OUT_H */
+  if (reg == LPS22CH_PRESS_OUT_L)
+  {
+    p = &buff[1];
+  }
+
+  ret = lps22ch_read_reg(ctx, reg, p, len);
+
+  if (ret != 0) { return ret; }
+
+  *press = buff[2];
+  *press = (*press * 256U) + buff[1];
+  *press = (*press * 256U) + buff[0];
+  *press *= 256U;
+
+  if ((res == LPS22CH_RES_PRESS_24BIT_TEMP) ||
+      (res == LPS22CH_RES_PRESS_16BIT_TEMP))
+  {
+    *temp = (int16_t)(buff[3] | ((uint16_t)buff[4] << 8));
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Raw FIFO records burst read.[get]
+  *         After FIFO_DATA_OUT_TEMP_H the address rolls back to
+  *         FIFO_DATA_OUT_PRESS_XL, so num records are popped with a
+  *         single transaction (IF_ADD_INC must be enabled).
+  *         Records are kept in device format so that they can be stored
+  *         as they are and decoded later.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  buff     buffer that stores the records read
+  * @param  num      number of records to read (max LPS22CH_FIFO_DEPTH)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_fifo_record_get(const stmdev_ctx_t *ctx,
+                                lps22ch_fifo_record_t *buff, uint8_t num)
+{
+  int32_t ret;
+
+  if ((num == 0U) || (num > LPS22CH_FIFO_DEPTH))
+  {
+    return -1;
+  }
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_DATA_OUT_PRESS_XL,
+                         (uint8_t *) buff,
+                         (uint16_t)num * LPS22CH_FIFO_RECORD_LEN);
+
+  return ret;
+}
+
+/**
+  * @brief  Decode a raw FIFO record. The outputs use the same format of
+  *         lps22ch_fifo_pressure_raw_get / lps22ch_fifo_temperature_raw_get
+  *         so they can be passed to the conversion functions.
+  *
+  * @param  rec      raw record read from FIFO
+  * @param  press    pressure output value (NULL to skip)
+  * @param  temp     temperature output value (NULL to skip)
+  *
+  */
+void lps22ch_fifo_record_decode(const lps22ch_fifo_record_t *rec,
+                                uint32_t *press, int16_t *temp)
+{
+  if (press != NULL)
+  {
+    *press = rec->press[2];
+    *press = (*press * 256U) + rec->press[1];
+    *press = (*press * 256U) + rec->press[0];
+    *press *= 256U;
+  }
+
+  if (temp != NULL)
+  {
+    *temp = (int16_t)(rec->temp[0] | ((uint16_t)rec->temp[1] << 8));
+  }
+}
+
+/**
+  * @brief  Convert an array of raw FIFO records into engineering units.
+  *         The function has no side effects, so large archives can be
+  *         split and converted concurrently by the caller. Results are
+  *         identical to lps22ch_from_lsb_to_hpa / lps22ch_from_lsb_to_celsius.
+  *
+  * @param  rec      raw records
+  * @param  hpa      pressure output array in hPa (NULL to skip)
+  * @param  deg_c    temperature output array in Celsius (NULL to skip)
+  * @param  num      number of records to convert
+  *
+  */
+void lps22ch_fifo_record_convert(const lps22ch_fifo_record_t *rec,
+                                 float_t *hpa, float_t *deg_c,
+                                 uint32_t num)
+{
+  uint32_t press;
+  int16_t temp;
+  uint32_t i;
+
+  for (i = 0U; i < num; i++)
+  {
+    if (hpa != NULL)
+    {
+      /* 24-bit value scaled by 1/4096, same as (raw << 8) / 1048576 */
+      press = ((uint32_t)rec[i].press[2] << 16) |
+              ((uint32_t)rec[i].press[1] << 8) | rec[i].press[0];
+      hpa[i] = (float_t)press * (1.0f / 4096.0f);
+    }
+
+    if (deg_c != NULL)
+    {
+      temp = (int16_t)(rec[i].temp[0] | ((uint16_t)rec[i].temp[1] << 8));
+      deg_c[i] = (float_t)temp / 100.0f;
+    }
+  }
+}
+
 /**
   * @}
   *
@@ -808,15 +1040,15 @@ int32_t lps22ch_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
   */
 int32_t lps22ch_reset_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret == 0)
   {
-    reg.swreset = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, SWRESET, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
   }
 
   return ret;
@@ -833,14 +1065,14 @@ int32_t lps22ch_reset_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_reset_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.swreset;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG2, SWRESET);
 
   return ret;
 }
@@ -857,15 +1089,15 @@ int32_t lps22ch_reset_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_auto_increment_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret == 0)
   {
-    reg.if_add_inc = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, IF_ADD_INC, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
   }
 
   return ret;
@@ -883,14 +1115,14 @@ int32_t lps22ch_auto_increment_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_auto_increment_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.if_add_inc;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG2, IF_ADD_INC);
 
   return ret;
 }
@@ -906,15 +1138,15 @@ int32_t lps22ch_auto_increment_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret == 0)
   {
-    reg.boot = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, BOOT, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
   }
 
   return ret;
@@ -931,14 +1163,14 @@ int32_t lps22ch_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.boot;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG2, BOOT);
 
   return ret;
 }
@@ -967,15 +1199,15 @@ int32_t lps22ch_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lps22ch_lp_bandwidth_set(const stmdev_ctx_t *ctx,
                                  lps22ch_lpfp_cfg_t val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret == 0)
   {
-    reg.lpfp_cfg = (uint8_t)val & 0x03U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG1, LPFP_CFG, (uint8_t)val & 0x03U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
   }
 
   return ret;
@@ -992,14 +1224,14 @@ int32_t lps22ch_lp_bandwidth_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_lp_bandwidth_get(const stmdev_ctx_t *ctx,
                                  lps22ch_lpfp_cfg_t *val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.lpfp_cfg)
+  switch (LPS22CH_FIELD_GET(reg, CTRL_REG1, LPFP_CFG))
   {
     case 0x00:
       *val = LPS22CH_LPF_ODR_DIV_2;
@@ -1045,15 +1277,15 @@ int32_t lps22ch_lp_bandwidth_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_i2c_interface_set(const stmdev_ctx_t *ctx,
                                   lps22ch_i2c_disable_t val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.i2c_disable = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, IF_CTRL, I2C_DISABLE, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1070,14 +1302,14 @@ int32_t lps22ch_i2c_interface_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_i2c_interface_get(const stmdev_ctx_t *ctx,
                                   lps22ch_i2c_disable_t *val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.i2c_disable)
+  switch (LPS22CH_FIELD_GET(reg, IF_CTRL, I2C_DISABLE))
   {
     case 0x00:
       *val = LPS22CH_I2C_ENABLE;
@@ -1106,16 +1338,16 @@ int32_t lps22ch_i2c_interface_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_i3c_interface_set(const stmdev_ctx_t *ctx,
                                   lps22ch_i3c_disable_t val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.i3c_disable = (uint8_t)val & 0x01U;
-    reg.int_en_i3c = (uint8_t)~val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *)&reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, IF_CTRL, I3C_DISABLE, (uint8_t)val & 0x01U);
+    reg = LPS22CH_FIELD_SET(reg, IF_CTRL, INT_EN_I3C, (uint8_t)~val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1132,14 +1364,14 @@ int32_t lps22ch_i3c_interface_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_i3c_interface_get(const stmdev_ctx_t *ctx,
                                   lps22ch_i3c_disable_t *val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.i3c_disable)
+  switch (LPS22CH_FIELD_GET(reg, IF_CTRL, I3C_DISABLE))
   {
     case 0x00:
       *val = LPS22CH_I3C_ENABLE;
@@ -1168,15 +1400,15 @@ int32_t lps22ch_i3c_interface_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_sdo_sa0_mode_set(const stmdev_ctx_t *ctx,
                                  lps22ch_pu_en_t val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.sdo_pu_en = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, IF_CTRL, SDO_PU_EN, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1193,14 +1425,14 @@ int32_t lps22ch_sdo_sa0_mode_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_sdo_sa0_mode_get(const stmdev_ctx_t *ctx,
                                  lps22ch_pu_en_t *val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.sdo_pu_en)
+  switch (LPS22CH_FIELD_GET(reg, IF_CTRL, SDO_PU_EN))
   {
     case 0x00:
       *val = LPS22CH_PULL_UP_DISCONNECT;
@@ -1228,15 +1460,15 @@ int32_t lps22ch_sdo_sa0_mode_get(const stmdev_ctx_t *ctx,
   */
 int32_t lps22ch_sda_mode_set(const stmdev_ctx_t *ctx, lps22ch_pu_en_t val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.sda_pu_en = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, IF_CTRL, SDA_PU_EN, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1252,14 +1484,14 @@ int32_t lps22ch_sda_mode_set(const stmdev_ctx_t *ctx, lps22ch_pu_en_t val)
   */
 int32_t lps22ch_sda_mode_get(const stmdev_ctx_t *ctx, lps22ch_pu_en_t *val)
 {
-  lps22ch_if_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_IF_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.sda_pu_en)
+  switch (LPS22CH_FIELD_GET(reg, IF_CTRL, SDA_PU_EN))
   {
     case 0x00:
       *val = LPS22CH_PULL_UP_DISCONNECT;
@@ -1287,15 +1519,15 @@ int32_t lps22ch_sda_mode_get(const stmdev_ctx_t *ctx, lps22ch_pu_en_t *val)
   */
 int32_t lps22ch_spi_mode_set(const stmdev_ctx_t *ctx, lps22ch_sim_t val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret == 0)
   {
-    reg.sim = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG1, SIM, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
   }
 
   return ret;
@@ -1311,14 +1543,14 @@ int32_t lps22ch_spi_mode_set(const stmdev_ctx_t *ctx, lps22ch_sim_t val)
   */
 int32_t lps22ch_spi_mode_get(const stmdev_ctx_t *ctx, lps22ch_sim_t *val)
 {
-  lps22ch_ctrl_reg1_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.sim)
+  switch (LPS22CH_FIELD_GET(reg, CTRL_REG1, SIM))
   {
     case 0x00:
       *val = LPS22CH_SPI_4_WIRE;
@@ -1360,15 +1592,15 @@ int32_t lps22ch_spi_mode_get(const stmdev_ctx_t *ctx, lps22ch_sim_t *val)
 int32_t lps22ch_int_notification_set(const stmdev_ctx_t *ctx,
                                      lps22ch_lir_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.lir = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, LIR, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -1385,14 +1617,14 @@ int32_t lps22ch_int_notification_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_int_notification_get(const stmdev_ctx_t *ctx,
                                      lps22ch_lir_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.lir)
+  switch (LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, LIR))
   {
     case 0x00:
       *val = LPS22CH_INT_PULSED;
@@ -1420,15 +1652,15 @@ int32_t lps22ch_int_notification_get(const stmdev_ctx_t *ctx,
   */
 int32_t lps22ch_pin_mode_set(const stmdev_ctx_t *ctx, lps22ch_pp_od_t val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret == 0)
   {
-    reg.pp_od = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, PP_OD, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
   }
 
   return ret;
@@ -1444,14 +1676,14 @@ int32_t lps22ch_pin_mode_set(const stmdev_ctx_t *ctx, lps22ch_pp_od_t val)
   */
 int32_t lps22ch_pin_mode_get(const stmdev_ctx_t *ctx, lps22ch_pp_od_t *val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.pp_od)
+  switch (LPS22CH_FIELD_GET(reg, CTRL_REG2, PP_OD))
   {
     case 0x00:
       *val = LPS22CH_PUSH_PULL;
@@ -1480,15 +1712,15 @@ int32_t lps22ch_pin_mode_get(const stmdev_ctx_t *ctx, lps22ch_pp_od_t *val)
 int32_t lps22ch_pin_polarity_set(const stmdev_ctx_t *ctx,
                                  lps22ch_int_h_l_t val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret == 0)
   {
-    reg.int_h_l = (uint8_t)val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, INT_H_L, (uint8_t)val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
   }
 
   return ret;
@@ -1505,14 +1737,14 @@ int32_t lps22ch_pin_polarity_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_pin_polarity_get(const stmdev_ctx_t *ctx,
                                  lps22ch_int_h_l_t *val)
 {
-  lps22ch_ctrl_reg2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.int_h_l)
+  switch (LPS22CH_FIELD_GET(reg, CTRL_REG2, INT_H_L))
   {
     case 0x00:
       *val = LPS22CH_ACTIVE_HIGH;
@@ -1590,26 +1822,26 @@ int32_t lps22ch_pin_int_route_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_int_on_threshold_set(const stmdev_ctx_t *ctx,
                                      lps22ch_pe_t val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret == 0)
   {
-    reg.pe = (uint8_t)val & 0x03U;
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, PE, (uint8_t)val & 0x03U);
 
     if (val == LPS22CH_NO_THRESHOLD)
     {
-      reg.diff_en = PROPERTY_DISABLE;
+      reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, DIFF_EN, PROPERTY_DISABLE);
     }
 
     else
     {
-      reg.diff_en = PROPERTY_ENABLE;
+      reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, DIFF_EN, PROPERTY_ENABLE);
     }
 
-    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
   }
 
   return ret;
@@ -1626,14 +1858,14 @@ int32_t lps22ch_int_on_threshold_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_int_on_threshold_get(const stmdev_ctx_t *ctx,
                                      lps22ch_pe_t *val)
 {
-  lps22ch_interrupt_cfg_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.pe)
+  switch (LPS22CH_FIELD_GET(reg, INTERRUPT_CFG, PE))
   {
     case 0x00:
       *val = LPS22CH_NO_THRESHOLD;
@@ -1671,17 +1903,15 @@ int32_t lps22ch_int_threshold_set(const stmdev_ctx_t *ctx, uint16_t buff)
 {
   int32_t ret;
 
-  lps22ch_ths_p_l_t ths_p_l;
-  lps22ch_ths_p_h_t ths_p_h;
-  ths_p_h.ths = (uint8_t)(buff / 256U) & 0x7FU;
-  ths_p_l.ths = (uint8_t)(buff - (ths_p_h.ths * 256U));
-  ret =  lps22ch_write_reg(ctx, LPS22CH_THS_P_L,
-                           (uint8_t *)&ths_p_l, 1);
+  uint8_t ths_p_l;
+  uint8_t ths_p_h;
+  ths_p_h = LPS22CH_FIELD_SET(0U, THS_P_H, THS, buff / 256U);
+  ths_p_l = LPS22CH_FIELD_SET(0U, THS_P_L, THS, buff & 0xFFU);
+  ret =  lps22ch_write_reg(ctx, LPS22CH_THS_P_L, &ths_p_l, 1);
 
   if (ret == 0)
   {
-    ret =  lps22ch_write_reg(ctx, LPS22CH_THS_P_H,
-                             (uint8_t *)&ths_p_h, 1);
+    ret =  lps22ch_write_reg(ctx, LPS22CH_THS_P_H, &ths_p_h, 1);
   }
 
   return ret;
@@ -1699,16 +1929,16 @@ int32_t lps22ch_int_threshold_get(const stmdev_ctx_t *ctx, uint16_t *buff)
 {
   int32_t ret;
 
-  lps22ch_ths_p_l_t ths_p_l;
-  lps22ch_ths_p_h_t ths_p_h;
-  ret = lps22ch_read_reg(ctx, LPS22CH_THS_P_L,
-                          (uint8_t *)&ths_p_l, 1);
-  ret += lps22ch_read_reg(ctx, LPS22CH_THS_P_H,
-                          (uint8_t *)&ths_p_h, 1);
+  uint8_t ths_p_l;
+  uint8_t ths_p_h;
+  ret = lps22ch_read_reg(ctx, LPS22CH_THS_P_L, &ths_p_l, 1);
+  ret += lps22ch_read_reg(ctx, LPS22CH_THS_P_H, &ths_p_h, 1);
 
   if (ret == 0)
   {
-    *buff = (uint16_t)(ths_p_l.ths | ((uint16_t)ths_p_h.ths << 8));
+    *buff = (uint16_t)(LPS22CH_FIELD_GET(ths_p_l, THS_P_L, THS) |
+                       ((uint16_t)LPS22CH_FIELD_GET(ths_p_h, THS_P_H, THS)
+                        << 8));
   }
 
   return ret;
@@ -1736,15 +1966,15 @@ int32_t lps22ch_int_threshold_get(const stmdev_ctx_t *ctx, uint16_t *buff)
   */
 int32_t lps22ch_fifo_mode_set(const stmdev_ctx_t *ctx, lps22ch_f_mode_t val)
 {
-  lps22ch_fifo_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.f_mode = (uint8_t)val & 0x07U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, FIFO_CTRL, F_MODE, (uint8_t)val & 0x07U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1761,14 +1991,14 @@ int32_t lps22ch_fifo_mode_set(const stmdev_ctx_t *ctx, lps22ch_f_mode_t val)
 int32_t lps22ch_fifo_mode_get(const stmdev_ctx_t *ctx,
                               lps22ch_f_mode_t *val)
 {
-  lps22ch_fifo_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.f_mode)
+  switch (LPS22CH_FIELD_GET(reg, FIFO_CTRL, F_MODE))
   {
     case 0x00:
       *val = LPS22CH_BYPASS_MODE;
@@ -1817,15 +2047,15 @@ int32_t lps22ch_fifo_mode_get(const stmdev_ctx_t *ctx,
   */
 int32_t lps22ch_fifo_stop_on_wtm_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_fifo_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
 
   if (ret == 0)
   {
-    reg.stop_on_wtm = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, FIFO_CTRL, STOP_ON_WTM, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
   }
 
   return ret;
@@ -1842,14 +2072,14 @@ int32_t lps22ch_fifo_stop_on_wtm_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_fifo_stop_on_wtm_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_fifo_ctrl_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.stop_on_wtm;
+  *val = LPS22CH_FIELD_GET(reg, FIFO_CTRL, STOP_ON_WTM);
 
   return ret;
 }
@@ -1864,15 +2094,15 @@ int32_t lps22ch_fifo_stop_on_wtm_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_fifo_wtm_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_WTM, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_WTM, &reg, 1);
 
   if (ret == 0)
   {
-    reg.wtm = val & 0x7FU;
-    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_WTM, (uint8_t *) &reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, FIFO_WTM, WTM, val & 0x7FU);
+    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_WTM, &reg, 1);
   }
 
   return ret;
@@ -1888,14 +2118,14 @@ int32_t lps22ch_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_fifo_wtm_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_WTM, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_WTM, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.wtm;
+  *val = LPS22CH_FIELD_GET(reg, FIFO_WTM, WTM);
 
   return ret;
 }
@@ -1945,14 +2175,14 @@ int32_t lps22ch_fifo_src_get(const stmdev_ctx_t *ctx,
   */
 int32_t lps22ch_fifo_full_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_fifo_status2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.fifo_full_ia;
+  *val = LPS22CH_FIELD_GET(reg, FIFO_STATUS2, FIFO_FULL_IA);
 
   return ret;
 }
@@ -1967,14 +2197,14 @@ int32_t lps22ch_fifo_full_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_fifo_status2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, (uint8_t *) &reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.fifo_ovr_ia;
+  *val = LPS22CH_FIELD_GET(reg, FIFO_STATUS2, FIFO_OVR_IA);
 
   return ret;
 }
@@ -1989,14 +2219,14 @@ int32_t lps22ch_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_fifo_wtm_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_fifo_status2_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS2, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.fifo_wtm_ia;
+  *val = LPS22CH_FIELD_GET(reg, FIFO_STATUS2, FIFO_WTM_IA);
 
   return ret;
 }
@@ -2011,15 +2241,15 @@ int32_t lps22ch_fifo_wtm_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lps22ch_fifo_ovr_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
 
   if (ret == 0)
   {
-    reg.int_f_ovr = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG3, INT_F_OVR, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
   }
 
   return ret;
@@ -2035,14 +2265,14 @@ int32_t lps22ch_fifo_ovr_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_fifo_ovr_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.int_f_ovr;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG3, INT_F_OVR);
 
   return ret;
 }
@@ -2058,15 +2288,15 @@ int32_t lps22ch_fifo_ovr_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lps22ch_fifo_threshold_on_int_set(const stmdev_ctx_t *ctx,
                                           uint8_t val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
 
   if (ret == 0)
   {
-    reg.int_f_wtm = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG3, INT_F_WTM, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
   }
 
   return ret;
@@ -2083,14 +2313,14 @@ int32_t lps22ch_fifo_threshold_on_int_set(const stmdev_ctx_t *ctx,
 int32_t lps22ch_fifo_threshold_on_int_get(const stmdev_ctx_t *ctx,
                                           uint8_t *val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.int_f_wtm;
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG3, INT_F_WTM);
 
   return ret;
 }
@@ -2105,15 +2335,15 @@ int32_t lps22ch_fifo_threshold_on_int_get(const stmdev_ctx_t *ctx,
   */
 int32_t lps22ch_fifo_full_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
 
   if (ret == 0)
   {
-    reg.int_f_full = val & 0x01U;
-    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG3, INT_F_FULL, val & 0x01U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
   }
 
   return ret;
@@ -2129,14 +2359,3544 @@ int32_t lps22ch_fifo_full_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lps22ch_fifo_full_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps22ch_ctrl_reg3_t reg;
+  uint8_t reg;
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = LPS22CH_FIELD_GET(reg, CTRL_REG3, INT_F_FULL);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_One_Shot
+  * @brief     This section groups the functions that manage one-shot
+  *            measurements without polling the STATUS register.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Time needed to get a new sample at the selected ODR.
+  *         For continuous modes it is the sample period, rounded up,
+  *         for one-shot the worst-case conversion time.
+  *         Conversion times are bounded by the highest ODR allowed in
+  *         each mode (200 Hz low-current, 75 Hz low-noise).
+  *
+  * @param  val      output data rate
+  * @retval          time in milliseconds (0 if power-down)
+  *
+  */
+uint32_t lps22ch_sample_time_ms_get(lps22ch_odr_t val)
+{
+  uint32_t ms;
+
+  switch (val)
+  {
+    case LPS22CH_ONE_SHOOT:
+      ms = LPS22CH_CONV_TIME_LOW_CURRENT_MS;
+      break;
+
+    case LPS22CH_1_Hz:
+    case LPS22CH_1_Hz_LOW_NOISE:
+      ms = 1000U;
+      break;
+
+    case LPS22CH_10_Hz:
+    case LPS22CH_10_Hz_LOW_NOISE:
+      ms = 100U;
+      break;
+
+    case LPS22CH_25_Hz:
+    case LPS22CH_25_Hz_LOW_NOISE:
+      ms = 40U;
+      break;
+
+    case LPS22CH_50_Hz:
+    case LPS22CH_50_Hz_LOW_NOISE:
+      ms = 20U;
+      break;
+
+    case LPS22CH_75_Hz:
+    case LPS22CH_75_Hz_LOW_NOISE:
+      ms = 14U;
+      break;
+
+    case LPS22CH_100_Hz:
+      ms = 10U;
+      break;
+
+    case LPS22CH_200_Hz:
+      ms = 5U;
+      break;
+
+    default:
+      ms = 0U;
+      break;
+  }
+
+  return ms;
+}
+
+/**
+  * @brief  Prepare the device for one-shot measurements: put it in
+  *         power-down and cache CTRL_REG2 so that every trigger
+  *         costs a single write.
+  *
+  * @param  ctx        read / write interface definitions
+  * @param  val        one-shot handler
+  * @param  low_noise  PROPERTY_ENABLE to use low-noise conversions
+  * @retval            interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_one_shot_init(const stmdev_ctx_t *ctx,
+                              lps22ch_one_shot_t *val, uint8_t low_noise)
+{
+  uint8_t ctrl_reg1;
+  uint8_t reg;
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, &ctrl_reg1, 1);
+  ret += lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &val->ctrl_reg2, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg1 = LPS22CH_FIELD_SET(ctrl_reg1, CTRL_REG1, ODR, 0x00U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, &ctrl_reg1, 1);
+  }
+
+  if (ret == 0)
+  {
+    reg = LPS22CH_FIELD_SET(val->ctrl_reg2, CTRL_REG2, LOW_NOISE_EN,
+                            low_noise & 0x01U);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, ONE_SHOT, PROPERTY_DISABLE);
+    reg = LPS22CH_FIELD_SET(reg, CTRL_REG2, SWRESET, PROPERTY_DISABLE);
+    val->ctrl_reg2 = LPS22CH_FIELD_SET(reg, CTRL_REG2, BOOT,
+                                       PROPERTY_DISABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &val->ctrl_reg2, 1);
+  }
+
+  val->state = LPS22CH_ONE_SHOT_IDLE;
+  val->wait_ms = (LPS22CH_FIELD_GET(val->ctrl_reg2, CTRL_REG2,
+                                    LOW_NOISE_EN) == PROPERTY_ENABLE) ?
+                 LPS22CH_CONV_TIME_LOW_NOISE_MS :
+                 LPS22CH_CONV_TIME_LOW_CURRENT_MS;
+
+  return ret;
+}
+
+/**
+  * @brief  Trigger a one-shot measurement (single write).
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      one-shot handler (see lps22ch_one_shot_init)
+  * @param  wait_ms  time after which data is ready (can be NULL)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_one_shot_start(const stmdev_ctx_t *ctx,
+                               lps22ch_one_shot_t *val, uint32_t *wait_ms)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  reg = LPS22CH_FIELD_SET(val->ctrl_reg2, CTRL_REG2, ONE_SHOT,
+                          PROPERTY_ENABLE);
+  ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &reg, 1);
+
+  if (ret == 0)
+  {
+    val->state = LPS22CH_ONE_SHOT_WAIT;
+  }
+
+  if (wait_ms != NULL)
+  {
+    *wait_ms = val->wait_ms;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Non-blocking completion of a one-shot measurement.
+  *         No bus access is done before the conversion deadline, then
+  *         status and data are read together. The measurement is
+  *         complete when val->state is LPS22CH_ONE_SHOT_DONE.
+  *
+  * @param  ctx         read / write interface definitions
+  * @param  val         one-shot handler
+  * @param  elapsed_ms  time elapsed since lps22ch_one_shot_start
+  * @param  data        status and raw output values
+  * @retval             interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_one_shot_poll(const stmdev_ctx_t *ctx,
+                              lps22ch_one_shot_t *val, uint32_t elapsed_ms,
+                              lps22ch_data_t *data)
+{
+  int32_t ret = 0;
+
+  if ((val->state == LPS22CH_ONE_SHOT_WAIT) && (elapsed_ms >= val->wait_ms))
+  {
+    ret = lps22ch_data_get(ctx, data);
+
+    if ((ret == 0) && (data->status.p_da == PROPERTY_ENABLE))
+    {
+      val->state = LPS22CH_ONE_SHOT_DONE;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Blocking one-shot measurement: trigger, sleep until the
+  *         conversion deadline and read status and data at once.
+  *
+  * @param  ctx      read / write interface definitions (mdelay needed)
+  * @param  val      one-shot handler (see lps22ch_one_shot_init)
+  * @param  data     status and raw output values
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_one_shot_get(const stmdev_ctx_t *ctx,
+                             lps22ch_one_shot_t *val, lps22ch_data_t *data)
+{
+  uint32_t wait_ms;
+  uint32_t retry;
   int32_t ret;
 
-  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, (uint8_t *)&reg, 1);
+  if (ctx->mdelay == NULL)
+  {
+    return -1;
+  }
+
+  ret = lps22ch_one_shot_start(ctx, val, &wait_ms);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.int_f_full;
+  ctx->mdelay(wait_ms);
+  ret = lps22ch_one_shot_poll(ctx, val, wait_ms, data);
+
+  /* conversion late w.r.t. the table: retry with 1 ms step */
+  for (retry = 0U; (ret == 0) && (val->state != LPS22CH_ONE_SHOT_DONE) &&
+       (retry < wait_ms); retry++)
+  {
+    ctx->mdelay(1U);
+    ret = lps22ch_one_shot_poll(ctx, val, wait_ms, data);
+  }
+
+  if ((ret == 0) && (val->state != LPS22CH_ONE_SHOT_DONE))
+  {
+    ret = -1;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Predictive_Polling
+  * @brief     This section groups the functions that read continuous
+  *            data sleeping until the next predicted sample instead of
+  *            busy-polling the STATUS register.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the predictive polling handler.
+  *         The sample period is seeded from the ODR and then learned
+  *         from the observed p_da transitions.
+  *
+  * @param  val      predictive polling handler
+  * @param  odr      output data rate currently set
+  *
+  */
+void lps22ch_drdy_pred_init(lps22ch_drdy_pred_t *val, lps22ch_odr_t odr)
+{
+  val->period_q4 = lps22ch_sample_time_ms_get(odr) * 16U;
+  val->guard_ms = 1U;
+  val->guard_max_ms = (val->period_q4 / 16U) / 2U;
+  val->status_reads = 0U;
+  val->samples = 0U;
+  val->misses = 0U;
+  val->overruns = 0U;
+}
+
+/**
+  * @brief  Wait for the next sample and read it.
+  *         Sleeps until just before the predicted sample, then reads
+  *         status and data in one transaction, repeating it with a
+  *         1 ms step only when the sample is not ready yet.
+  *         The guard band is enlarged on overrun and reduced when
+  *         waking up too early.
+  *
+  * @param  ctx      read / write interface definitions (mdelay needed)
+  * @param  val      predictive polling handler
+  * @param  data     status and raw output values
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_drdy_pred_read(const stmdev_ctx_t *ctx,
+                               lps22ch_drdy_pred_t *val,
+                               lps22ch_data_t *data)
+{
+  uint32_t sleep_ms;
+  uint32_t miss = 0U;
+  uint32_t limit;
+  int32_t ret;
+
+  if (ctx->mdelay == NULL)
+  {
+    return -1;
+  }
+
+  sleep_ms = val->period_q4 / 16U;
+  sleep_ms = (sleep_ms > val->guard_ms) ? (sleep_ms - val->guard_ms) : 0U;
+
+  if (sleep_ms > 0U)
+  {
+    ctx->mdelay(sleep_ms);
+  }
+
+  /* never wait more than twice the period seeded at init */
+  limit = (val->guard_max_ms * 4U) + 2U;
+  ret = lps22ch_data_get(ctx, data);
+  val->status_reads++;
+
+  while ((ret == 0) && (data->status.p_da == PROPERTY_DISABLE) &&
+         (miss < limit))
+  {
+    ctx->mdelay(1U);
+    miss++;
+    ret = lps22ch_data_get(ctx, data);
+    val->status_reads++;
+  }
+
+  if (ret != 0) { return ret; }
+
+  if (data->status.p_da == PROPERTY_DISABLE)
+  {
+    return -1;
+  }
+
+  val->samples++;
+  val->misses += miss;
+
+  if (miss > 0U)
+  {
+    /* p_da transition observed: sleep + miss is the actual wait */
+    val->period_q4 = val->period_q4 - (val->period_q4 / 8U) +
+                     (((sleep_ms + miss) * 16U) / 8U);
+
+    if ((miss > 1U) && (val->guard_ms > 0U))
+    {
+      val->guard_ms--;
+    }
+  }
+
+  if ((data->status.p_or == PROPERTY_ENABLE) ||
+      (data->status.t_or == PROPERTY_ENABLE))
+  {
+    val->overruns++;
+
+    if (val->guard_ms < val->guard_max_ms)
+    {
+      val->guard_ms++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Average number of status reads per delivered sample.
+  *
+  * @param  val      predictive polling handler
+  * @retval          status reads per sample (0 if no sample yet)
+  *
+  */
+float_t lps22ch_drdy_pred_reads_per_sample(const lps22ch_drdy_pred_t *val)
+{
+  if (val->samples == 0U)
+  {
+    return 0.0f;
+  }
+
+  return ((float_t)val->status_reads / (float_t)val->samples);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Init
+  * @brief     This section groups the functions that configure the
+  *            device with burst transactions and bring up several
+  *            devices at once.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Write a full configuration image.
+  *         Four bursts are used, skipping WHO_AM_I (0Fh) and the
+  *         reserved address 17h. CTRL_REG1 (ODR) and FIFO_CTRL are
+  *         written last, after thresholds, offsets, FIFO_WTM and REF_P,
+  *         so the FIFO mode never starts with a stale watermark.
+  *         swreset and boot bits of the image are ignored.
+  *         With AUTOREFP or AUTOZERO set in the image the device
+  *         reloads REF_P at the first conversion and the REF_P of the
+  *         image is lost (see lps22ch_recover_restore).[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      configuration image
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_cfg_set(const stmdev_ctx_t *ctx, const lps22ch_cfg_t *val)
+{
+  uint8_t buff[7];
+  int32_t ret;
+
+  buff[0] = *(const uint8_t *) & (val->interrupt_cfg);
+  buff[1] = *(const uint8_t *) & (val->ths_p_l);
+  buff[2] = *(const uint8_t *) & (val->ths_p_h);
+  buff[3] = *(const uint8_t *) & (val->if_ctrl);
+  ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, buff, 4);
+
+  if (ret == 0)
+  {
+    buff[0] = (uint8_t)((uint16_t)val->rpds & 0xFFU);
+    buff[1] = (uint8_t)((uint16_t)val->rpds >> 8);
+    ret = lps22ch_write_reg(ctx, LPS22CH_RPDS_L, buff, 2);
+  }
+
+  if (ret == 0)
+  {
+    buff[0] = *(const uint8_t *) & (val->fifo_wtm);
+    buff[1] = (uint8_t)((uint16_t)val->ref_p & 0xFFU);
+    buff[2] = (uint8_t)((uint16_t)val->ref_p >> 8);
+    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_WTM, buff, 3);
+  }
+
+  if (ret == 0)
+  {
+    buff[0] = *(const uint8_t *) & (val->ctrl_reg1);
+    buff[1] = LPS22CH_FIELD_SET(*(const uint8_t *) & (val->ctrl_reg2),
+                                CTRL_REG2, SWRESET, PROPERTY_DISABLE);
+    buff[1] = LPS22CH_FIELD_SET(buff[1], CTRL_REG2, BOOT, PROPERTY_DISABLE);
+    buff[2] = *(const uint8_t *) & (val->ctrl_reg3);
+    buff[3] = *(const uint8_t *) & (val->fifo_ctrl);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG1, buff, 4);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read a full configuration image (three bursts).[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      configuration image
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_cfg_get(const stmdev_ctx_t *ctx, lps22ch_cfg_t *val)
+{
+  uint8_t buff[7];
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, buff, 4);
+
+  if (ret != 0) { return ret; }
+
+  *(uint8_t *) & (val->interrupt_cfg) = buff[0];
+  *(uint8_t *) & (val->ths_p_l) = buff[1];
+  *(uint8_t *) & (val->ths_p_h) = buff[2];
+  *(uint8_t *) & (val->if_ctrl) = buff[3];
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_RPDS_L, buff, 2);
+
+  if (ret != 0) { return ret; }
+
+  val->rpds = (int16_t)(buff[0] | ((uint16_t)buff[1] << 8));
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG1, buff, 7);
+
+  if (ret != 0) { return ret; }
+
+  *(uint8_t *) & (val->ctrl_reg1) = buff[0];
+  *(uint8_t *) & (val->ctrl_reg2) = buff[1];
+  *(uint8_t *) & (val->ctrl_reg3) = buff[2];
+  *(uint8_t *) & (val->fifo_ctrl) = buff[3];
+  *(uint8_t *) & (val->fifo_wtm) = buff[4];
+  val->ref_p = (int16_t)(buff[5] | ((uint16_t)buff[6] << 8));
+
+  return ret;
+}
+
+/**
+  * @brief  Prepare the init handler of one device.
+  *
+  * @param  val      init handler
+  * @param  ctx      read / write interface definitions of the device
+  * @param  cfg      configuration image to apply (NULL to skip)
+  * @param  boot     PROPERTY_ENABLE to reboot memory content after reset
+  *
+  */
+void lps22ch_init_prepare(lps22ch_init_t *val, const stmdev_ctx_t *ctx,
+                          const lps22ch_cfg_t *cfg, uint8_t boot)
+{
+  val->ctx = ctx;
+  val->cfg = cfg;
+  val->boot = boot;
+  val->state = LPS22CH_INIT_ID;
+  val->polls = 0U;
+  val->ret = 0;
+}
+
+/**
+  * @brief  Advance the init sequence of several devices by one step.
+  *         Each device does at most one transaction per call, so the
+  *         reset / boot waits of all devices overlap.
+  *
+  * @param  val      array of init handlers
+  * @param  num      number of handlers
+  * @retval          number of devices still in progress
+  *
+  */
+uint8_t lps22ch_init_step(lps22ch_init_t *val, uint8_t num)
+{
+  uint8_t ctrl_reg2;
+  lps22ch_init_t *dev;
+  uint8_t pending = 0U;
+  uint8_t id;
+  uint8_t i;
+
+  for (i = 0U; i < num; i++)
+  {
+    dev = &val[i];
+
+    switch (dev->state)
+    {
+      case LPS22CH_INIT_ID:
+        dev->ret = lps22ch_device_id_get(dev->ctx, &id);
+
+        if ((dev->ret == 0) && (id != LPS22CH_ID))
+        {
+          dev->ret = -1;
+        }
+
+        dev->state = LPS22CH_INIT_RESET;
+        break;
+
+      case LPS22CH_INIT_RESET:
+      case LPS22CH_INIT_BOOT:
+        /* reset restores defaults: no need for read-modify-write */
+        ctrl_reg2 = LPS22CH_FIELD_SET(0x00U, CTRL_REG2, IF_ADD_INC,
+                                      PROPERTY_ENABLE);
+
+        if (dev->state == LPS22CH_INIT_RESET)
+        {
+          ctrl_reg2 = LPS22CH_FIELD_SET(ctrl_reg2, CTRL_REG2, SWRESET,
+                                        PROPERTY_ENABLE);
+        }
+
+        else
+        {
+          ctrl_reg2 = LPS22CH_FIELD_SET(ctrl_reg2, CTRL_REG2, BOOT,
+                                        PROPERTY_ENABLE);
+        }
+
+        dev->ret = lps22ch_write_reg(dev->ctx, LPS22CH_CTRL_REG2,
+                                     &ctrl_reg2, 1);
+        dev->polls = 0U;
+        dev->state = (dev->state == LPS22CH_INIT_RESET) ?
+                     LPS22CH_INIT_RESET_WAIT : LPS22CH_INIT_BOOT_WAIT;
+        break;
+
+      case LPS22CH_INIT_RESET_WAIT:
+      case LPS22CH_INIT_BOOT_WAIT:
+        dev->ret = lps22ch_read_reg(dev->ctx, LPS22CH_CTRL_REG2,
+                                    &ctrl_reg2, 1);
+        dev->polls++;
+
+        if ((dev->ret == 0) &&
+            (LPS22CH_FIELD_GET(ctrl_reg2, CTRL_REG2, SWRESET) ==
+             PROPERTY_DISABLE) &&
+            (LPS22CH_FIELD_GET(ctrl_reg2, CTRL_REG2, BOOT) ==
+             PROPERTY_DISABLE))
+        {
+          if ((dev->state == LPS22CH_INIT_RESET_WAIT) &&
+              (dev->boot == PROPERTY_ENABLE))
+          {
+            dev->state = LPS22CH_INIT_BOOT;
+          }
+
+          else
+          {
+            dev->state = LPS22CH_INIT_CONFIG;
+          }
+        }
+
+        else if (dev->polls >= LPS22CH_INIT_MAX_POLLS)
+        {
+          dev->ret = -1;
+        }
+
+        else
+        {
+          /* keep waiting */
+        }
+        break;
+
+      case LPS22CH_INIT_CONFIG:
+        if (dev->cfg != NULL)
+        {
+          dev->ret = lps22ch_cfg_set(dev->ctx, dev->cfg);
+        }
+
+        dev->state = LPS22CH_INIT_DONE;
+        break;
+
+      default:
+        /* LPS22CH_INIT_DONE / LPS22CH_INIT_ERROR */
+        break;
+    }
+
+    if (dev->ret != 0)
+    {
+      dev->state = LPS22CH_INIT_ERROR;
+    }
+
+    if ((dev->state != LPS22CH_INIT_DONE) &&
+        (dev->state != LPS22CH_INIT_ERROR))
+    {
+      pending++;
+    }
+  }
+
+  return pending;
+}
+
+/**
+  * @brief  Bring up several devices at once: WHO_AM_I check, software
+  *         reset, optional reboot and configuration burst.
+  *         A single 1 ms delay is shared by all devices between steps.
+  *
+  * @param  val      array of prepared init handlers
+  * @param  num      number of handlers
+  * @param  mdelay   delay function (can be NULL)
+  * @retval          0 if all devices are configured, -1 otherwise
+  *                  (see the state / ret of each handler)
+  *
+  */
+int32_t lps22ch_init_run(lps22ch_init_t *val, uint8_t num,
+                         stmdev_mdelay_ptr mdelay)
+{
+  uint8_t i;
+
+  while (lps22ch_init_step(val, num) > 0U)
+  {
+    if (mdelay != NULL)
+    {
+      mdelay(1U);
+    }
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    if (val[i].state != LPS22CH_INIT_DONE)
+    {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Fifo_Watermark_Drain
+  * @brief     This section groups the functions that drain the FIFO on
+  *            watermark interrupt without reading the FIFO level.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Program watermark and stop-on-watermark with a single
+  *         read / write of FIFO_CTRL and FIFO_WTM, and remember the
+  *         watermark for lps22ch_fifo_wtm_drain.
+  *
+  * @param  ctx          read / write interface definitions
+  * @param  val          drain handler
+  * @param  wtm          watermark level (1 to 127)
+  * @param  check_every  read FIFO status once every check_every drains
+  *                      (0 to never check)
+  * @retval              interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_fifo_wtm_drain_init(const stmdev_ctx_t *ctx,
+                                    lps22ch_fifo_wtm_drain_t *val,
+                                    uint8_t wtm, uint8_t check_every)
+{
+  uint8_t buff[2];
+  int32_t ret;
+
+  if ((wtm & 0x7FU) == 0U)
+  {
+    return -1;
+  }
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, buff, 2);
+
+  if (ret != 0) { return ret; }
+
+  buff[0] = LPS22CH_FIELD_SET(buff[0], FIFO_CTRL, STOP_ON_WTM,
+                              PROPERTY_ENABLE);
+  buff[1] = LPS22CH_FIELD_SET(buff[1], FIFO_WTM, WTM, wtm & 0x7FU);
+  ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, buff, 2);
+
+  val->wtm = wtm & 0x7FU;
+  val->check_every = check_every;
+  val->count = 0U;
+  val->level = 0U;
+  *(uint8_t *) & (val->fifo_status2) = 0U;
+  val->drains = 0U;
+  val->desync = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Drain exactly the programmed watermark on FIFO watermark
+  *         interrupt. With stop-on-watermark the FIFO holds wtm
+  *         records at that point, so they are read with one burst and
+  *         no FIFO level pre-read. Once every check_every drains the
+  *         FIFO status is read back to verify that nothing was lost.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      drain handler (see lps22ch_fifo_wtm_drain_init)
+  * @param  buff     buffer of at least val->wtm records
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_fifo_wtm_drain(const stmdev_ctx_t *ctx,
+                               lps22ch_fifo_wtm_drain_t *val,
+                               lps22ch_fifo_record_t *buff)
+{
+  uint8_t status[2];
+  int32_t ret;
+
+  ret = lps22ch_fifo_record_get(ctx, buff, val->wtm);
+
+  if (ret != 0) { return ret; }
+
+  val->drains++;
+
+  if (val->check_every == 0U)
+  {
+    return ret;
+  }
+
+  val->count++;
+
+  if (val->count >= val->check_every)
+  {
+    val->count = 0U;
+    ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS1, status, 2);
+
+    if (ret != 0) { return ret; }
+
+    val->level = status[0];
+    *(uint8_t *) & (val->fifo_status2) = status[1];
+
+    if ((val->level >= val->wtm) ||
+        (LPS22CH_FIELD_GET(status[1], FIFO_STATUS2, FIFO_OVR_IA) ==
+         PROPERTY_ENABLE))
+    {
+      val->desync++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Dynamic_Stream
+  * @brief     This section groups the functions that manage a gapless
+  *            continuous acquisition based on dynamic-stream FIFO mode.
+  * @{
+  *
+  */
+
+/* empty the FIFO through bypass, then write buff (FIFO_CTRL first) */
+static int32_t lps22ch_fifo_restart(const stmdev_ctx_t *ctx, uint8_t *buff,
+                                    uint16_t len, lps22ch_f_mode_t mode)
+{
+  int32_t ret;
+
+  buff[0] = LPS22CH_FIELD_SET(buff[0], FIFO_CTRL, F_MODE,
+                              LPS22CH_BYPASS_MODE);
+  buff[0] = LPS22CH_FIELD_SET(buff[0], FIFO_CTRL, STOP_ON_WTM,
+                              PROPERTY_DISABLE);
+  ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, buff, 1);
+
+  if (ret == 0)
+  {
+    buff[0] = LPS22CH_FIELD_SET(buff[0], FIFO_CTRL, F_MODE,
+                                (uint8_t)mode & 0x07U);
+    ret = lps22ch_write_reg(ctx, LPS22CH_FIFO_CTRL, buff, len);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Clear the FIFO and start dynamic-stream mode.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      stream handler
+  * @param  wtm      watermark level (0 to disable)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_stream_start(const stmdev_ctx_t *ctx, lps22ch_stream_t *val,
+                             uint8_t wtm)
+{
+  uint8_t buff[2];
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, buff, 2);
+
+  if (ret != 0) { return ret; }
+
+  buff[1] = LPS22CH_FIELD_SET(buff[1], FIFO_WTM, WTM, wtm & 0x7FU);
+  ret = lps22ch_fifo_restart(ctx, buff, 2, LPS22CH_DYNAMIC_STREAM_MODE);
+
+  val->seq = 0U;
+  val->batches = 0U;
+  val->gaps = 0U;
+  val->level = 0U;
+  val->ovr = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Read the next batch of records.
+  *         The FIFO level read at the end of the previous call is used
+  *         to size the burst: the level can only grow meanwhile, so
+  *         the burst starts right away without a status round-trip,
+  *         records are never read twice and never read from an empty
+  *         FIFO. FIFO status is read after the burst and gives the size
+  *         of the next batch. Every record gets a sequence number and
+  *         FIFO overruns are reported as a gap on the following batch.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      stream handler (see lps22ch_stream_start)
+  * @param  buff     buffer that stores the records read
+  * @param  max      size of buff in records
+  * @param  batch    sequence information of the records read
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_stream_read(const stmdev_ctx_t *ctx, lps22ch_stream_t *val,
+                            lps22ch_fifo_record_t *buff, uint8_t max,
+                            lps22ch_stream_batch_t *batch)
+{
+  uint8_t status[2];
+  uint8_t num;
+  int32_t ret = 0;
+
+  num = (val->level < max) ? val->level : max;
+
+  if (num > 0U)
+  {
+    ret = lps22ch_fifo_record_get(ctx, buff, num);
+  }
+
+  if (ret != 0) { return ret; }
+
+  batch->first_seq = val->seq;
+  batch->num = num;
+  batch->gap = val->ovr;
+  val->seq += num;
+  val->ovr = 0U;
+
+  if (num > 0U)
+  {
+    val->batches++;
+  }
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_FIFO_STATUS1, status, 2);
+
+  if (ret != 0) { return ret; }
+
+  val->level = status[0];
+
+  if (LPS22CH_FIELD_GET(status[1], FIFO_STATUS2, FIFO_OVR_IA) ==
+      PROPERTY_ENABLE)
+  {
+    val->ovr = 1U;
+    val->gaps++;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Event_Capture
+  * @brief     This section groups the functions that capture pressure
+  *            events in FIFO using the trigger modes and the
+  *            interrupt on threshold.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Arm an event capture: enable the latched interrupt on
+  *         threshold and restart the FIFO in a trigger mode.
+  *         Threshold and reference must already be programmed.
+  *         With LPS22CH_STREAM_TO_FIFO_MODE the FIFO keeps the
+  *         pre-trigger history, then fills the post-trigger window
+  *         until full; the host can sleep until the FIFO full interrupt.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      event handler
+  * @param  mode     LPS22CH_BYPASS_TO_FIFO_MODE,
+  *                  LPS22CH_BYPASS_TO_STREAM_MODE or
+  *                  LPS22CH_STREAM_TO_FIFO_MODE
+  * @param  pe       pressure event(s) that trigger the capture
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_event_arm(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                          lps22ch_f_mode_t mode, lps22ch_pe_t pe)
+{
+  uint8_t interrupt_cfg;
+  uint8_t fifo_ctrl;
+  int32_t ret;
+
+  if (((mode != LPS22CH_BYPASS_TO_FIFO_MODE) &&
+       (mode != LPS22CH_BYPASS_TO_STREAM_MODE) &&
+       (mode != LPS22CH_STREAM_TO_FIFO_MODE)) ||
+      (pe == LPS22CH_NO_THRESHOLD))
+  {
+    return -1;
+  }
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &interrupt_cfg, 1);
+  ret += lps22ch_read_reg(ctx, LPS22CH_FIFO_CTRL, &fifo_ctrl, 1);
+
+  if (ret == 0)
+  {
+    interrupt_cfg = LPS22CH_FIELD_SET(interrupt_cfg, INTERRUPT_CFG, PE,
+                                      (uint8_t)pe & 0x03U);
+    interrupt_cfg = LPS22CH_FIELD_SET(interrupt_cfg, INTERRUPT_CFG, DIFF_EN,
+                                      PROPERTY_ENABLE);
+    interrupt_cfg = LPS22CH_FIELD_SET(interrupt_cfg, INTERRUPT_CFG, LIR,
+                                      PROPERTY_ENABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &interrupt_cfg, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_fifo_restart(ctx, &fifo_ctrl, 1, mode);
+  }
+
+  val->mode = mode;
+  val->triggered = 0U;
+  val->pre = 0U;
+  val->num = 0U;
+  val->timestamp = 0U;
+  *(uint8_t *) & (val->int_source) = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  To be called on the threshold interrupt. Reads INT_SOURCE
+  *         (clearing the latched request), FIFO level and status with a
+  *         single transaction and records where the event falls in the
+  *         FIFO.
+  *
+  * @param  ctx        read / write interface definitions
+  * @param  val        event handler
+  * @param  timestamp  host time of the interrupt (any unit)
+  * @retval            interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_event_trigger(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                              uint32_t timestamp)
+{
+  uint8_t buff[4];
+  int32_t ret;
+
+  /* INT_SOURCE, FIFO_STATUS1, FIFO_STATUS2, STATUS */
+  ret = lps22ch_read_reg(ctx, LPS22CH_INT_SOURCE, buff, 4);
+
+  if (ret != 0) { return ret; }
+
+  *(uint8_t *) & (val->int_source) = buff[0];
+
+  if ((val->triggered == 0U) &&
+      (LPS22CH_FIELD_GET(buff[0], INT_SOURCE, IA) == PROPERTY_ENABLE))
+  {
+    val->triggered = 1U;
+    val->timestamp = timestamp;
+    val->pre = (val->mode == LPS22CH_STREAM_TO_FIFO_MODE) ? buff[1] : 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Collect the event record: pre-trigger history followed by the
+  *         post-trigger window, read with one burst. Record i was
+  *         sampled (i - val->pre) ODR periods after the event. To be
+  *         called once the post-trigger window is complete (e.g. on FIFO
+  *         full interrupt); re-arm with lps22ch_event_arm afterwards.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      event handler
+  * @param  buff     buffer that stores the records read
+  * @param  max      size of buff in records
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_event_collect(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                              lps22ch_fifo_record_t *buff, uint8_t max)
+{
+  uint8_t level;
+  int32_t ret;
+
+  val->num = 0U;
+
+  if (val->triggered == 0U)
+  {
+    return 0;
+  }
+
+  ret = lps22ch_fifo_data_level_get(ctx, &level);
+
+  if (ret != 0) { return ret; }
+
+  val->num = (level < max) ? level : max;
+
+  if (val->num > 0U)
+  {
+    ret = lps22ch_fifo_record_get(ctx, buff, val->num);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Threshold_Monitor
+  * @brief     This section groups the functions that monitor pressure
+  *            against thresholds in hPa using the interrupt on threshold.
+  * @{
+  *
+  */
+
+/* write REF_P and read it back: AUTOREFP must not have overwritten it */
+static int32_t lps22ch_ref_p_check_set(const stmdev_ctx_t *ctx, int16_t ref)
+{
+  int16_t check;
+  int32_t ret;
+
+  ret = lps22ch_pressure_ref_set(ctx, ref);
+
+  if (ret == 0)
+  {
+    ret = lps22ch_pressure_ref_get(ctx, &check);
+  }
+
+  if ((ret == 0) && (check != ref))
+  {
+    ret = -1;
+  }
+
+  return ret;
+}
+
+/* drop the pending sample, then wait (at most two periods) for the
+   conversion that loads REF_P after AUTOREFP / AUTOZERO was enabled */
+static int32_t lps22ch_ref_p_load_wait(const stmdev_ctx_t *ctx,
+                                       uint32_t period)
+{
+  lps22ch_data_t data;
+  uint32_t step;
+  uint32_t wait;
+  int32_t ret;
+
+  step = (period >= 8U) ? (period / 8U) : 1U;
+  wait = period;
+  ret = lps22ch_data_get(ctx, &data);
+
+  if (ret == 0)
+  {
+    ctx->mdelay(period);
+    ret = lps22ch_data_get(ctx, &data);
+  }
+
+  while ((ret == 0) && (data.status.p_da == PROPERTY_DISABLE))
+  {
+    if (wait > ((2U * period) + 2U))
+    {
+      ret = -1;
+      break;
+    }
+
+    ctx->mdelay(step);
+    wait += step;
+    ret = lps22ch_data_get(ctx, &data);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Program a pressure window in hPa with hysteresis.
+  *         The window is centred on REF_P with half-width THS_P; when it
+  *         is left, lps22ch_ths_mon_handle moves REF_P so that the event
+  *         clears only once pressure is back by more than hyst_hpa.
+  *         AUTOREFP is enabled so that the interrupt is generated on
+  *         PRESS_OUT - REF_P (output data stays absolute). AUTOREFP
+  *         loads REF_P at the next conversion: the first new sample is
+  *         awaited (one sample period, then a few polls), then REF_P is
+  *         overwritten with the window centre and read back.
+  *         INTERRUPT_CFG and THS_P are written with one burst, REF_P
+  *         with another. Interrupt request is latched.
+  *         The device must be in a continuous mode (mdelay needed).
+  *
+  * @param  ctx       read / write interface definitions
+  * @param  val       threshold monitor handler
+  * @param  low_hpa   low threshold (hPa)
+  * @param  high_hpa  high threshold (hPa)
+  * @param  hyst_hpa  hysteresis (hPa), less than high_hpa - low_hpa
+  * @retval           interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_ths_mon_set(const stmdev_ctx_t *ctx, lps22ch_ths_mon_t *val,
+                            float_t low_hpa, float_t high_hpa,
+                            float_t hyst_hpa)
+{
+  lps22ch_odr_t odr;
+  uint16_t ths;
+  float_t half;
+  uint8_t buff[3];
+  int32_t ret;
+
+  if ((high_hpa <= low_hpa) || (hyst_hpa < 0.0f) ||
+      (hyst_hpa >= (high_hpa - low_hpa)) || (ctx->mdelay == NULL))
+  {
+    return -1;
+  }
+
+  ret = lps22ch_data_rate_get(ctx, &odr);
+
+  if (ret != 0) { return ret; }
+
+  if ((odr == LPS22CH_POWER_DOWN) || (odr == LPS22CH_ONE_SHOOT))
+  {
+    return -1;
+  }
+
+  half = (high_hpa - low_hpa) / 2.0f;
+  ths = lps22ch_from_hpa_to_ths(half);
+  val->ref[LPS22CH_THS_MON_NORMAL] = lps22ch_from_hpa_to_ref(low_hpa + half);
+  /* high: event clears below high - hyst; low: above low + hyst */
+  val->ref[LPS22CH_THS_MON_HIGH] =
+    lps22ch_from_hpa_to_ref(high_hpa - hyst_hpa + half);
+  val->ref[LPS22CH_THS_MON_LOW] =
+    lps22ch_from_hpa_to_ref(low_hpa + hyst_hpa - half);
+  val->state = LPS22CH_THS_MON_NORMAL;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, buff, 1);
+
+  if (ret == 0)
+  {
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, PE, LPS22CH_BOTH);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, DIFF_EN,
+                                PROPERTY_ENABLE);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, LIR,
+                                PROPERTY_ENABLE);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, AUTOZERO,
+                                PROPERTY_DISABLE);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, AUTOREFP,
+                                PROPERTY_ENABLE);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, RESET_AZ,
+                                PROPERTY_DISABLE);
+    buff[0] = LPS22CH_FIELD_SET(buff[0], INTERRUPT_CFG, RESET_ARP,
+                                PROPERTY_DISABLE);
+    buff[1] = (uint8_t)(ths & 0xFFU);
+    buff[2] = (uint8_t)(ths >> 8) & 0x7FU;
+    val->interrupt_cfg = buff[0];
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, buff, 3);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_ref_p_load_wait(ctx, lps22ch_sample_time_ms_get(odr));
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_ref_p_check_set(ctx, val->ref[LPS22CH_THS_MON_NORMAL]);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  To be called on the threshold interrupt. Reads INT_SOURCE,
+  *         updates the monitor state and, on a state change, re-arms
+  *         the window: INTERRUPT_CFG (cached, no read) selects the only
+  *         event that can leave the new state, then REF_P is written
+  *         with a single burst and read back to check. AUTOREFP is not
+  *         toggled, so the reference is not reloaded by the device.
+  *         Transitions: NORMAL -> HIGH on ph, NORMAL -> LOW on pl,
+  *         HIGH / LOW -> NORMAL once pressure is back past the
+  *         hysteresis. In HIGH only pl is enabled and in LOW only ph,
+  *         so a pressure that stays beyond the window does not raise
+  *         an interrupt at every sample.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      threshold monitor handler
+  * @param  src      INT_SOURCE read (can be NULL)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_ths_mon_handle(const stmdev_ctx_t *ctx,
+                               lps22ch_ths_mon_t *val,
+                               lps22ch_int_source_t *src)
+{
+  lps22ch_ths_mon_state_t state;
+  lps22ch_pe_t pe;
+  uint8_t reg;
+  uint8_t cfg;
+  uint8_t pl;
+  uint8_t ph;
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INT_SOURCE, &reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  pl = LPS22CH_FIELD_GET(reg, INT_SOURCE, PL);
+  ph = LPS22CH_FIELD_GET(reg, INT_SOURCE, PH);
+  state = val->state;
+
+  switch (val->state)
+  {
+    case LPS22CH_THS_MON_HIGH:
+      if (pl == PROPERTY_ENABLE)
+      {
+        state = LPS22CH_THS_MON_NORMAL;
+      }
+      break;
+
+    case LPS22CH_THS_MON_LOW:
+      if (ph == PROPERTY_ENABLE)
+      {
+        state = LPS22CH_THS_MON_NORMAL;
+      }
+      break;
+
+    default:
+      if (ph == PROPERTY_ENABLE)
+      {
+        state = LPS22CH_THS_MON_HIGH;
+      }
+
+      else if (pl == PROPERTY_ENABLE)
+      {
+        state = LPS22CH_THS_MON_LOW;
+      }
+
+      else
+      {
+        /* no pressure event */
+      }
+      break;
+  }
+
+  if (state != val->state)
+  {
+    switch (state)
+    {
+      case LPS22CH_THS_MON_HIGH:
+        pe = LPS22CH_NEGATIVE;
+        break;
+
+      case LPS22CH_THS_MON_LOW:
+        pe = LPS22CH_POSITIVE;
+        break;
+
+      default:
+        pe = LPS22CH_BOTH;
+        break;
+    }
+
+    cfg = LPS22CH_FIELD_SET(val->interrupt_cfg, INTERRUPT_CFG, PE, pe);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &cfg, 1);
+
+    if (ret == 0)
+    {
+      val->interrupt_cfg = cfg;
+      ret = lps22ch_ref_p_check_set(ctx, val->ref[state]);
+    }
+
+    if (ret == 0)
+    {
+      val->state = state;
+    }
+  }
+
+  if (src != NULL)
+  {
+    *(uint8_t *) src = reg;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Relative_Pressure
+  * @brief     This section groups the functions that deliver relative
+  *            and absolute pressure using the autozero function.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Enable autozero: the next sample is stored in REF_P and the
+  *         output becomes PRESS_OUT - REF_P. INTERRUPT_CFG is cached so
+  *         that re-zeroing needs no register read. A sample pending
+  *         when autozero is enabled was converted before it and is
+  *         dropped, so that REF_P is read only once loaded.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      relative pressure handler
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_rel_press_start(const stmdev_ctx_t *ctx,
+                                lps22ch_rel_press_t *val)
+{
+  lps22ch_data_t raw;
+  uint8_t reg;
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
+
+  if (ret == 0)
+  {
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_AZ, PROPERTY_DISABLE);
+    reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_ARP, PROPERTY_DISABLE);
+    val->interrupt_cfg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, AUTOZERO,
+                                           PROPERTY_ENABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG,
+                            &val->interrupt_cfg, 1);
+  }
+
+  /* drop a sample converted before autozero was enabled */
+  if (ret == 0)
+  {
+    ret = lps22ch_data_get(ctx, &raw);
+  }
+
+  val->ref = 0;
+  val->ref_valid = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Read status, relative pressure and temperature with a single
+  *         transaction. REF_P is read only once, after the first sample
+  *         that follows lps22ch_rel_press_start / lps22ch_rel_press_rezero,
+  *         and then used to rebuild the absolute value of each sample.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      relative pressure handler
+  * @param  data     status, relative / absolute pressure, temperature
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_rel_press_get(const stmdev_ctx_t *ctx,
+                              lps22ch_rel_press_t *val,
+                              lps22ch_rel_data_t *data)
+{
+  lps22ch_data_t raw;
+  int32_t ret;
+
+  ret = lps22ch_data_get(ctx, &raw);
+
+  if (ret != 0) { return ret; }
+
+  if ((val->ref_valid == 0U) && (raw.status.p_da == PROPERTY_ENABLE))
+  {
+    ret = lps22ch_pressure_ref_get(ctx, &val->ref);
+
+    if (ret != 0) { return ret; }
+
+    val->ref_valid = 1U;
+  }
+
+  data->status = raw.status;
+  data->temp_raw = raw.temp_raw;
+  data->rel_raw = (int32_t)raw.press_raw;
+  /* REF_P is aligned to PRESS_OUT_H:L, 16 bit below press_raw MSB */
+  data->abs_raw = (uint32_t)(data->rel_raw + ((int32_t)val->ref * 65536));
+
+  return ret;
+}
+
+/**
+  * @brief  Capture a new reference without reading INTERRUPT_CFG:
+  *         autozero is reset and enabled again with two writes, then
+  *         the pending sample, converted with the old reference, is
+  *         dropped.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      relative pressure handler
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_rel_press_rezero(const stmdev_ctx_t *ctx,
+                                 lps22ch_rel_press_t *val)
+{
+  lps22ch_data_t raw;
+  uint8_t reg;
+  int32_t ret;
+
+  reg = LPS22CH_FIELD_SET(val->interrupt_cfg, INTERRUPT_CFG, AUTOZERO,
+                          PROPERTY_DISABLE);
+  reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_AZ, PROPERTY_ENABLE);
+  ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
+
+  if (ret == 0)
+  {
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG,
+                            &val->interrupt_cfg, 1);
+  }
+
+  /* REF_P is 0 until the next conversion loads it */
+  if (ret == 0)
+  {
+    ret = lps22ch_data_get(ctx, &raw);
+  }
+
+  val->ref_valid = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Disable autozero, output is absolute again.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      relative pressure handler
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_rel_press_stop(const stmdev_ctx_t *ctx,
+                               lps22ch_rel_press_t *val)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  reg = LPS22CH_FIELD_SET(val->interrupt_cfg, INTERRUPT_CFG, AUTOZERO,
+                          PROPERTY_DISABLE);
+  reg = LPS22CH_FIELD_SET(reg, INTERRUPT_CFG, RESET_AZ, PROPERTY_ENABLE);
+  ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
+
+  if (ret == 0)
+  {
+    val->interrupt_cfg = LPS22CH_FIELD_SET(val->interrupt_cfg, INTERRUPT_CFG,
+                                           AUTOZERO, PROPERTY_DISABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG,
+                            &val->interrupt_cfg, 1);
+  }
+
+  val->ref_valid = 0U;
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Offset_Calibration
+  * @brief     This section groups the functions that compute and write
+  *            the pressure offset (RPDS) of several devices at once.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Prepare the calibration handler of one device.
+  *
+  * @param  val      calibration handler
+  * @param  ctx      read / write interface definitions of the device
+  *
+  */
+void lps22ch_calib_prepare(lps22ch_calib_t *val, const stmdev_ctx_t *ctx)
+{
+  val->ctx = ctx;
+  val->num = 0U;
+  val->fifo_ctrl = 0U;
+  val->rpds_old = 0;
+  val->rpds = 0;
+  val->mean_hpa = 0.0f;
+  val->spread_hpa = 0.0f;
+  val->ret = 0;
+}
+
+/**
+  * @brief  Start sample collection on all devices: the current offset
+  *         is saved and the FIFO is restarted in FIFO mode, so that all
+  *         devices fill their FIFO at the same time.
+  *         Devices must be already running at the wanted ODR.
+  *
+  * @param  val      array of prepared calibration handlers
+  * @param  num_dev  number of handlers
+  * @retval          0 if all devices started, -1 otherwise (see ret)
+  *
+  */
+int32_t lps22ch_calib_start(lps22ch_calib_t *val, uint8_t num_dev)
+{
+  uint8_t fifo_ctrl;
+  lps22ch_calib_t *dev;
+  int32_t ret = 0;
+  uint8_t i;
+
+  for (i = 0U; i < num_dev; i++)
+  {
+    dev = &val[i];
+    dev->num = 0U;
+    dev->ret = lps22ch_pressure_offset_get(dev->ctx, &dev->rpds_old);
+
+    if (dev->ret == 0)
+    {
+      dev->ret = lps22ch_read_reg(dev->ctx, LPS22CH_FIFO_CTRL,
+                                  &dev->fifo_ctrl, 1);
+    }
+
+    if (dev->ret == 0)
+    {
+      fifo_ctrl = dev->fifo_ctrl;
+      dev->ret = lps22ch_fifo_restart(dev->ctx, &fifo_ctrl, 1,
+                                      LPS22CH_FIFO_MODE);
+    }
+
+    if (dev->ret != 0)
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Collect samples from all devices: one FIFO level read per
+  *         device and, once enough samples are stored, one burst.
+  *         To be called periodically until it returns 0.
+  *
+  * @param  val      array of calibration handlers
+  * @param  num_dev  number of handlers
+  * @param  samples  samples to collect (max LPS22CH_CALIB_MAX_SAMPLES)
+  * @retval          number of devices still collecting
+  *
+  */
+uint8_t lps22ch_calib_step(lps22ch_calib_t *val, uint8_t num_dev,
+                           uint8_t samples)
+{
+  lps22ch_fifo_record_t rec[LPS22CH_CALIB_MAX_SAMPLES];
+  lps22ch_calib_t *dev;
+  uint8_t pending = 0U;
+  uint8_t level;
+  uint8_t i;
+  uint8_t j;
+
+  if (samples > LPS22CH_CALIB_MAX_SAMPLES)
+  {
+    samples = LPS22CH_CALIB_MAX_SAMPLES;
+  }
+
+  for (i = 0U; i < num_dev; i++)
+  {
+    dev = &val[i];
+
+    if ((dev->ret != 0) || (dev->num >= samples))
+    {
+      continue;
+    }
+
+    dev->ret = lps22ch_fifo_data_level_get(dev->ctx, &level);
+
+    if ((dev->ret == 0) && (level >= samples))
+    {
+      dev->ret = lps22ch_fifo_record_get(dev->ctx, rec, samples);
+
+      if (dev->ret == 0)
+      {
+        for (j = 0U; j < samples; j++)
+        {
+          lps22ch_fifo_record_decode(&rec[j], &dev->press[j], NULL);
+        }
+
+        dev->num = samples;
+      }
+    }
+
+    if ((dev->ret == 0) && (dev->num < samples))
+    {
+      pending++;
+    }
+  }
+
+  return pending;
+}
+
+/**
+  * @brief  Compute the trimmed mean of the samples of each device.
+  *         A device with no more than 2 * trim samples gets ret = -1
+  *         and is refused by lps22ch_calib_apply.
+  *
+  * @param  val      array of calibration handlers
+  * @param  num_dev  number of handlers
+  * @param  trim     samples discarded at each end of the sorted set
+  *
+  */
+void lps22ch_calib_compute(lps22ch_calib_t *val, uint8_t num_dev,
+                           uint8_t trim)
+{
+  lps22ch_calib_t *dev;
+  uint32_t tmp;
+  uint64_t sum;
+  uint8_t i;
+  uint8_t j;
+  uint8_t k;
+
+  for (i = 0U; i < num_dev; i++)
+  {
+    dev = &val[i];
+
+    if (dev->ret != 0)
+    {
+      continue;
+    }
+
+    if (dev->num <= (2U * trim))
+    {
+      /* no sample left to average */
+      dev->ret = -1;
+      continue;
+    }
+
+    /* insertion sort, few samples */
+    for (j = 1U; j < dev->num; j++)
+    {
+      tmp = dev->press[j];
+
+      for (k = j; (k > 0U) && (dev->press[k - 1U] > tmp); k--)
+      {
+        dev->press[k] = dev->press[k - 1U];
+      }
+
+      dev->press[k] = tmp;
+    }
+
+    sum = 0U;
+
+    for (j = trim; j < (dev->num - trim); j++)
+    {
+      sum += dev->press[j];
+    }
+
+    dev->mean_hpa = lps22ch_from_lsb_to_hpa((uint32_t)(sum /
+                                            (uint64_t)(dev->num - (2U * trim))));
+    dev->spread_hpa = lps22ch_from_lsb_to_hpa(dev->press[dev->num - trim - 1U]) -
+                      lps22ch_from_lsb_to_hpa(dev->press[trim]);
+  }
+}
+
+/**
+  * @brief  Compute the new offsets against a reference pressure and
+  *         write them, one RPDS burst per device. FIFO mode in use
+  *         before lps22ch_calib_start is restored.
+  *         The reference can be a known pressure or the mean_hpa of a
+  *         reference device.
+  *
+  * @param  val      array of calibration handlers
+  * @param  num_dev  number of handlers
+  * @param  ref_hpa  reference pressure (hPa)
+  * @retval          0 if all devices are calibrated, -1 otherwise
+  *
+  */
+int32_t lps22ch_calib_apply(lps22ch_calib_t *val, uint8_t num_dev,
+                            float_t ref_hpa)
+{
+  lps22ch_calib_t *dev;
+  int32_t rpds;
+  int32_t ret = 0;
+  uint8_t i;
+
+  for (i = 0U; i < num_dev; i++)
+  {
+    dev = &val[i];
+
+    if ((dev->ret == 0) && (dev->num == 0U))
+    {
+      dev->ret = -1;
+    }
+
+    if (dev->ret == 0)
+    {
+      /* RPDS is subtracted from the output, 16 LSB/hPa */
+      rpds = (int32_t)dev->rpds_old +
+             (int32_t)lps22ch_from_hpa_to_ref(dev->mean_hpa - ref_hpa);
+      rpds = (rpds > 32767) ? 32767 : rpds;
+      rpds = (rpds < -32768) ? -32768 : rpds;
+      dev->rpds = (int16_t)rpds;
+      dev->ret = lps22ch_pressure_offset_set(dev->ctx, dev->rpds);
+    }
+
+    if (dev->ret == 0)
+    {
+      dev->ret = lps22ch_write_reg(dev->ctx, LPS22CH_FIFO_CTRL,
+                                   &dev->fifo_ctrl, 1);
+    }
+
+    if (dev->ret != 0)
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Read_Planner
+  * @brief     This section groups the functions that plan the reads of
+  *            a set of registers according to a bus cost model.
+  * @{
+  *
+  */
+
+/*
+ * Registers that can be read as filler inside a burst, generated from
+ * the register map: readable, no read side effect (INT_SOURCE clears
+ * latched requests, output registers clear data-ready and release BDU)
+ * and not reserved.
+ */
+#define LPS22CH_REG_BIT_IF(reg, cond)                                     \
+  | ((((LPS22CH_##reg) < 64U) && (cond)) ?                               \
+     LPS22CH_PLAN_REG((LPS22CH_##reg) & 63U) : 0U)
+#define LPS22CH_PLAN_SPAN_BIT(reg, access, reset)                         \
+  LPS22CH_REG_BIT_IF(reg, ((access) & (LPS22CH_REG_R |                   \
+                                       LPS22CH_REG_RD_CLEAR)) ==          \
+                          LPS22CH_REG_R)
+#define LPS22CH_PLAN_SPAN_MASK                                              \
+  ((uint64_t)0U LPS22CH_REG_LIST(LPS22CH_PLAN_SPAN_BIT))
+
+/**
+  * @brief  Build the cheapest read plan for a set of registers.
+  *         Two consecutive needed registers are read with the same
+  *         burst when the registers in between can be read without
+  *         side effects and reading them costs less than a new
+  *         transaction. The plan can be reused every cycle.
+  *
+  * @param  cost     bus cost model (e.g. I2C 100 kHz vs SPI 10 MHz)
+  * @param  regs     set of registers (LPS22CH_PLAN_REG(reg) flags)
+  * @param  val      read plan
+  * @retval          0 -> no Error, -1 invalid set or too many segments
+  *
+  */
+int32_t lps22ch_plan_build(const lps22ch_bus_cost_t *cost, uint64_t regs,
+                           lps22ch_plan_t *val)
+{
+  lps22ch_plan_seg_t *seg = NULL;
+  uint64_t gap_mask;
+  uint8_t last = 0U;
+  uint8_t reg;
+
+  val->num = 0U;
+  val->cost = 0U;
+
+  if ((regs == 0U) || ((regs >> LPS22CH_PLAN_MAP_SIZE) != 0U))
+  {
+    return -1;
+  }
+
+  for (reg = 0U; reg < LPS22CH_PLAN_MAP_SIZE; reg++)
+  {
+    if ((regs & LPS22CH_PLAN_REG(reg)) == 0U)
+    {
+      continue;
+    }
+
+    if (seg != NULL)
+    {
+      /* registers strictly between last and reg */
+      gap_mask = (LPS22CH_PLAN_REG(reg) - 1U) &
+                 ~((LPS22CH_PLAN_REG(last) << 1) - 1U);
+
+      if (((gap_mask & ~LPS22CH_PLAN_SPAN_MASK) == 0U) &&
+          (((uint32_t)(reg - last - 1U) * cost->byte_cost) <
+           cost->xfer_cost))
+      {
+        seg->len = (uint8_t)(reg - seg->reg + 1U);
+        last = reg;
+        continue;
+      }
+    }
+
+    if (val->num >= LPS22CH_PLAN_MAX_SEG)
+    {
+      return -1;
+    }
+
+    seg = &val->seg[val->num];
+    seg->reg = reg;
+    seg->len = 1U;
+    val->num++;
+    last = reg;
+  }
+
+  for (reg = 0U; reg < val->num; reg++)
+  {
+    val->cost += cost->xfer_cost +
+                 ((uint32_t)val->seg[reg].len * cost->byte_cost);
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Execute a read plan.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      read plan (see lps22ch_plan_build)
+  * @param  image    register image indexed by register address
+  *                  (LPS22CH_PLAN_MAP_SIZE bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_plan_exec(const stmdev_ctx_t *ctx, const lps22ch_plan_t *val,
+                          uint8_t *image)
+{
+  int32_t ret = 0;
+  uint8_t i;
+
+  for (i = 0U; (i < val->num) && (ret == 0); i++)
+  {
+    ret = lps22ch_read_reg(ctx, val->seg[i].reg, &image[val->seg[i].reg],
+                           val->seg[i].len);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+#ifdef LPS22CH_MEM_BARRIER
+
+/**
+  * @defgroup  LPS22CH_Latest_Sample
+  * @brief     This section groups the functions that share the last
+  *            sample with any number of readers without bus access and
+  *            without locks (sequence lock, single writer).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the latest sample cache (nothing published).
+  *
+  * @param  val      latest sample cache
+  *
+  */
+void lps22ch_latest_init(lps22ch_latest_t *val)
+{
+  val->seq = 0U;
+  LPS22CH_MEM_BARRIER();
+}
+
+/**
+  * @brief  Publish a new sample (acquisition path only, single writer).
+  *         Values are converted once here so readers get them for free.
+  *
+  * @param  val        latest sample cache
+  * @param  data       status and raw output values
+  * @param  timestamp  host time of the sample (any unit)
+  *
+  */
+void lps22ch_latest_publish(lps22ch_latest_t *val, const lps22ch_data_t *data,
+                            uint32_t timestamp)
+{
+  lps22ch_sample_t sample;
+
+  sample.data = *data;
+  sample.hpa = lps22ch_from_lsb_to_hpa(data->press_raw);
+  sample.deg_c = lps22ch_from_lsb_to_celsius(data->temp_raw);
+  sample.timestamp = timestamp;
+
+  val->seq = val->seq + 1U;
+  LPS22CH_MEM_BARRIER();
+  val->sample = sample;
+  LPS22CH_MEM_BARRIER();
+  val->seq = val->seq + 1U;
+}
+
+/**
+  * @brief  Get a consistent copy of the last published sample.
+  *         Retries while the writer is updating it.
+  *
+  * @param  val      latest sample cache
+  * @param  sample   copy of the last sample
+  * @retval          0 -> sample copied, -1 -> nothing published yet
+  *
+  */
+int32_t lps22ch_latest_read(const lps22ch_latest_t *val,
+                            lps22ch_sample_t *sample)
+{
+  uint32_t start;
+  uint32_t end;
+
+  do
+  {
+    start = val->seq;
+    LPS22CH_MEM_BARRIER();
+    *sample = val->sample;
+    LPS22CH_MEM_BARRIER();
+    end = val->seq;
+  } while ((start != end) || ((start & 0x01U) != 0U));
+
+  return (start == 0U) ? -1 : 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Broadcast_Ring
+  * @brief     This section groups the functions that broadcast FIFO
+  *            records from one producer to many consumers.
+  *            The ring only uses indexes, so it can be placed in memory
+  *            shared between processes; wake-up of consumers is left to
+  *            the platform (e.g. eventfd / futex).
+  * @{
+  *
+  */
+
+#if ((LPS22CH_RING_SIZE & (LPS22CH_RING_SIZE - 1U)) != 0U)
+#error "LPS22CH_RING_SIZE must be a power of 2"
+#endif /* LPS22CH_RING_SIZE */
+
+/**
+  * @brief  Initialize the broadcast ring.
+  *
+  * @param  val      ring
+  *
+  */
+void lps22ch_ring_init(lps22ch_ring_t *val)
+{
+  val->reserve = 0U;
+  val->head = 0U;
+  LPS22CH_MEM_BARRIER();
+}
+
+/**
+  * @brief  Publish records (single producer). The producer never waits
+  *         for consumers: slow consumers lose the oldest records.
+  *
+  * @param  val      ring
+  * @param  rec      records to publish
+  * @param  num      number of records (max LPS22CH_RING_SIZE)
+  *
+  */
+void lps22ch_ring_publish(lps22ch_ring_t *val,
+                          const lps22ch_fifo_record_t *rec, uint32_t num)
+{
+  uint32_t mask = LPS22CH_RING_SIZE - 1U;
+  uint32_t head = val->head;
+  uint32_t i;
+
+  val->reserve = head + num;
+  LPS22CH_MEM_BARRIER();
+
+  for (i = 0U; i < num; i++)
+  {
+    val->rec[(head + i) & mask] = rec[i];
+  }
+
+  LPS22CH_MEM_BARRIER();
+  val->head = head + num;
+}
+
+/**
+  * @brief  Drain FIFO records straight into the ring (single producer),
+  *         with one burst, or two when the ring wraps around.
+  *         Records are published only if every burst succeeds.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      ring
+  * @param  num      number of records to read (max LPS22CH_FIFO_DEPTH)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_ring_fifo_read(const stmdev_ctx_t *ctx, lps22ch_ring_t *val,
+                               uint8_t num)
+{
+  uint32_t mask = LPS22CH_RING_SIZE - 1U;
+  uint32_t head = val->head;
+  uint32_t first;
+  int32_t ret;
+
+  first = LPS22CH_RING_SIZE - (head & mask);
+  first = (first < num) ? first : num;
+
+  if ((num == 0U) || ((num - first) > (head & mask)))
+  {
+    /* zero or more records than the ring can hold */
+    return -1;
+  }
+
+  val->reserve = head + num;
+  LPS22CH_MEM_BARRIER();
+
+  ret = lps22ch_fifo_record_get(ctx, &val->rec[head & mask], (uint8_t)first);
+
+  if ((ret == 0) && (first < num))
+  {
+    ret = lps22ch_fifo_record_get(ctx, &val->rec[0], num - (uint8_t)first);
+  }
+
+  if (ret == 0)
+  {
+    LPS22CH_MEM_BARRIER();
+    val->head = head + num;
+  }
+
+  /*
+   * on error nothing is published: the slots may be partially written,
+   * readers overlapping them already count them as lost (reserve)
+   */
+  return ret;
+}
+
+/**
+  * @brief  Attach a consumer: it will receive records published from
+  *         now on.
+  *
+  * @param  val      ring
+  * @param  cur      consumer cursor
+  *
+  */
+void lps22ch_ring_cursor_init(const lps22ch_ring_t *val,
+                              lps22ch_ring_cursor_t *cur)
+{
+  cur->tail = val->head;
+  cur->lost = 0U;
+}
+
+/**
+  * @brief  Get the contiguous span of records available to a consumer,
+  *         without copying them. Records overwritten before being read
+  *         are skipped and counted in cur->lost.
+  *
+  * @param  val      ring
+  * @param  cur      consumer cursor
+  * @param  rec      first available record
+  * @retval          number of records available at rec
+  *
+  */
+uint32_t lps22ch_ring_peek(const lps22ch_ring_t *val,
+                           lps22ch_ring_cursor_t *cur,
+                           const lps22ch_fifo_record_t **rec)
+{
+  uint32_t mask = LPS22CH_RING_SIZE - 1U;
+  uint32_t head;
+  uint32_t num;
+  uint32_t span;
+
+  head = val->head;
+  LPS22CH_MEM_BARRIER();
+
+  if ((head - cur->tail) > LPS22CH_RING_SIZE)
+  {
+    cur->lost += (head - cur->tail) - LPS22CH_RING_SIZE;
+    cur->tail = head - LPS22CH_RING_SIZE;
+  }
+
+  num = head - cur->tail;
+  span = LPS22CH_RING_SIZE - (cur->tail & mask);
+  *rec = &val->rec[cur->tail & mask];
+
+  return (num < span) ? num : span;
+}
+
+/**
+  * @brief  Release records obtained with lps22ch_ring_peek.
+  *         Fails if the producer overwrote them while they were used,
+  *         in which case the data must be discarded.
+  *
+  * @param  val      ring
+  * @param  cur      consumer cursor
+  * @param  num      number of records consumed
+  * @retval          0 -> records were valid, -1 -> records overwritten
+  *
+  */
+int32_t lps22ch_ring_release(const lps22ch_ring_t *val,
+                             lps22ch_ring_cursor_t *cur, uint32_t num)
+{
+  uint32_t reserve;
+  int32_t ret = 0;
+
+  LPS22CH_MEM_BARRIER();
+  reserve = val->reserve;
+
+  if ((reserve - cur->tail) > LPS22CH_RING_SIZE)
+  {
+    cur->lost += num;
+    ret = -1;
+  }
+
+  cur->tail += num;
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+#endif /* LPS22CH_MEM_BARRIER */
+
+/**
+  * @defgroup  LPS22CH_Split_Transfers
+  * @brief     This section groups the functions that split driver
+  *            operations into a transfer description and a decoding
+  *            step, so that transfers can be completed asynchronously
+  *            by any executor (event loop, coroutine, DMA).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Describe a generic register transfer.
+  *
+  * @param  xfer     transfer description
+  * @param  reg      first register
+  * @param  buff     data to write / buffer that stores data read
+  * @param  len      number of consecutive registers
+  * @param  write    PROPERTY_ENABLE for a write transfer
+  *
+  */
+void lps22ch_xfer_reg_prepare(lps22ch_xfer_t *xfer, uint8_t reg,
+                              uint8_t *buff, uint16_t len, uint8_t write)
+{
+  xfer->reg = reg;
+  xfer->write = write;
+  xfer->len = len;
+  xfer->buff = buff;
+}
+
+/**
+  * @brief  Describe the read of STATUS..TEMP_OUT_H (lps22ch_data_get).
+  *
+  * @param  xfer     transfer description
+  * @param  buff     buffer of 6 bytes that stores data read
+  *
+  */
+void lps22ch_xfer_data_prepare(lps22ch_xfer_t *xfer, uint8_t *buff)
+{
+  lps22ch_xfer_reg_prepare(xfer, LPS22CH_STATUS, buff, 6U,
+                           PROPERTY_DISABLE);
+}
+
+/**
+  * @brief  Decode a completed lps22ch_xfer_data_prepare transfer.
+  *
+  * @param  xfer     completed transfer
+  * @param  val      status register and raw output values
+  *
+  */
+void lps22ch_xfer_data_decode(const lps22ch_xfer_t *xfer,
+                              lps22ch_data_t *val)
+{
+  const uint8_t *buff = xfer->buff;
+
+  *(uint8_t *) & (val->status) = buff[0];
+  val->press_raw = buff[3];
+  val->press_raw = (val->press_raw * 256U) + buff[2];
+  val->press_raw = (val->press_raw * 256U) + buff[1];
+  val->press_raw *= 256U;
+  val->temp_raw = (int16_t)(buff[4] | ((uint16_t)buff[5] << 8));
+}
+
+/**
+  * @brief  Describe a FIFO drain of num records (lps22ch_fifo_record_get).
+  *         Records are decoded with lps22ch_fifo_record_decode.
+  *
+  * @param  xfer     transfer description
+  * @param  buff     buffer that stores the records read
+  * @param  num      number of records (max LPS22CH_FIFO_DEPTH)
+  * @retval          0 -> no Error, -1 invalid num
+  *
+  */
+int32_t lps22ch_xfer_fifo_prepare(lps22ch_xfer_t *xfer,
+                                  lps22ch_fifo_record_t *buff, uint8_t num)
+{
+  if ((num == 0U) || (num > LPS22CH_FIFO_DEPTH))
+  {
+    return -1;
+  }
+
+  lps22ch_xfer_reg_prepare(xfer, LPS22CH_FIFO_DATA_OUT_PRESS_XL,
+                           (uint8_t *) buff,
+                           (uint16_t)num * LPS22CH_FIFO_RECORD_LEN,
+                           PROPERTY_DISABLE);
+
+  return 0;
+}
+
+/**
+  * @brief  Describe a one-shot trigger (lps22ch_one_shot_start).
+  *         The handler switches to LPS22CH_ONE_SHOT_WAIT: once the
+  *         transfer is done, wait val->wait_ms and complete with
+  *         lps22ch_xfer_data_prepare / lps22ch_xfer_data_decode.
+  *
+  * @param  xfer     transfer description
+  * @param  val      one-shot handler (see lps22ch_one_shot_init)
+  * @param  buff     buffer of 1 byte that stores data to write
+  *
+  */
+void lps22ch_xfer_one_shot_prepare(lps22ch_xfer_t *xfer,
+                                   lps22ch_one_shot_t *val, uint8_t *buff)
+{
+  buff[0] = LPS22CH_FIELD_SET(val->ctrl_reg2, CTRL_REG2, ONE_SHOT,
+                              PROPERTY_ENABLE);
+  val->state = LPS22CH_ONE_SHOT_WAIT;
+  lps22ch_xfer_reg_prepare(xfer, LPS22CH_CTRL_REG2, buff, 1U,
+                           PROPERTY_ENABLE);
+}
+
+/**
+  * @brief  Execute a transfer synchronously through the context.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  xfer     transfer description
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_xfer_exec(const stmdev_ctx_t *ctx,
+                          const lps22ch_xfer_t *xfer)
+{
+  int32_t ret;
+
+  if (xfer->write == PROPERTY_ENABLE)
+  {
+    ret = lps22ch_write_reg(ctx, xfer->reg, xfer->buff, xfer->len);
+  }
+
+  else
+  {
+    ret = lps22ch_read_reg(ctx, xfer->reg, xfer->buff, xfer->len);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Hybrid_Acquisition
+  * @brief     This section groups the functions that switch between
+  *            DRDY interrupt and polling, depending on load.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Route DRDY on INT_DRDY pin and start in interrupt mode.
+  *         Other CTRL_REG3 bits are preserved and cached: CTRL_REG3
+  *         must not be changed elsewhere while the handler is in use.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      hybrid acquisition handler
+  * @param  idle_max consecutive empty polls before DRDY is unmasked
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_napi_init(const stmdev_ctx_t *ctx, lps22ch_napi_t *val,
+                          uint32_t idle_max)
+{
+  int32_t ret;
+
+  val->mode = LPS22CH_NAPI_IRQ;
+  val->idle_max = idle_max;
+  val->idle = 0U;
+  val->irqs = 0U;
+  val->polls = 0U;
+  val->samples = 0U;
+  val->to_poll = 0U;
+  val->to_irq = 0U;
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &val->ctrl_reg3, 1);
+
+  if (ret == 0)
+  {
+    val->ctrl_reg3 = LPS22CH_FIELD_SET(val->ctrl_reg3, CTRL_REG3, DRDY,
+                                       PROPERTY_ENABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &val->ctrl_reg3, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  DRDY interrupt entry: mask DRDY and switch to polling.
+  *         The caller then schedules lps22ch_napi_poll until mode
+  *         returns to LPS22CH_NAPI_IRQ, so under high ODR the pin
+  *         stays masked and the interrupt rate stays flat.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      hybrid acquisition handler
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_napi_irq(const stmdev_ctx_t *ctx, lps22ch_napi_t *val)
+{
+  uint8_t reg;
+  int32_t ret = 0;
+
+  val->irqs++;
+
+  if (val->mode == LPS22CH_NAPI_IRQ)
+  {
+    reg = LPS22CH_FIELD_SET(val->ctrl_reg3, CTRL_REG3, DRDY,
+                            PROPERTY_DISABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &reg, 1);
+
+    if (ret == 0)
+    {
+      val->mode = LPS22CH_NAPI_POLL;
+      val->idle = 0U;
+      val->to_poll++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Deliver at most one sample from the combined STATUS +
+  *         output window with a single burst: the output registers
+  *         hold one sample only, so a second read in the same poll
+  *         would always find p_da cleared. Poll at least at the ODR
+  *         to keep up with the device. After idle_max consecutive empty
+  *         polls DRDY is unmasked and mode returns to LPS22CH_NAPI_IRQ.
+  *         The device has no pulsed DRDY mode: DRDY stays asserted
+  *         until the output registers are read, so a sample that lands
+  *         before unmasking raises the pin as soon as DRDY is routed.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      hybrid acquisition handler
+  * @param  data     status and output values read
+  * @param  num      number of samples delivered (0 or 1)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_napi_poll(const stmdev_ctx_t *ctx, lps22ch_napi_t *val,
+                          lps22ch_data_t *data, uint32_t *num)
+{
+  int32_t ret;
+
+  *num = 0U;
+  val->polls++;
+  ret = lps22ch_data_get(ctx, data);
+
+  if (ret != 0) { return ret; }
+
+  if (data->status.p_da == PROPERTY_ENABLE)
+  {
+    *num = 1U;
+  }
+
+  val->samples += *num;
+
+  if (*num > 0U)
+  {
+    val->idle = 0U;
+  }
+
+  else if ((val->mode == LPS22CH_NAPI_POLL) &&
+           (++val->idle >= val->idle_max))
+  {
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &val->ctrl_reg3, 1);
+
+    if (ret == 0)
+    {
+      val->mode = LPS22CH_NAPI_IRQ;
+      val->to_irq++;
+    }
+  }
+
+  else
+  {
+    /* empty poll below the idle threshold: keep polling */
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_DRDY_Fast_Path
+  * @brief     This section groups the functions of the minimal-latency
+  *            DRDY path for per-sample control loops.
+  * @{
+  *
+  */
+
+#ifdef LPS22CH_FAST_READ
+extern int32_t LPS22CH_FAST_READ(void *handle, uint8_t reg, uint8_t *data,
+                                 uint16_t len);
+#endif /* LPS22CH_FAST_READ */
+
+#ifdef LPS22CH_FAST_CALLBACK
+extern void LPS22CH_FAST_CALLBACK(void *arg, int32_t press_q12,
+                                  int16_t temp_c100);
+#endif /* LPS22CH_FAST_CALLBACK */
+
+/**
+  * @brief  Prepare the DRDY fast path and route DRDY on INT_DRDY pin.
+  *         All checks are done here, none in lps22ch_fast_isr.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      fast path handler
+  * @param  cb       sample callback (ignored with LPS22CH_FAST_CALLBACK)
+  * @param  arg      callback argument
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_fast_init(const stmdev_ctx_t *ctx, lps22ch_fast_t *val,
+                          lps22ch_fast_cb_t cb, void *arg)
+{
+  uint8_t ctrl_reg3;
+  uint8_t ctrl_reg2;
+  int32_t ret;
+
+#ifndef LPS22CH_FAST_CALLBACK
+
+  if (cb == NULL)
+  {
+    return -1;
+  }
+
+#endif /* LPS22CH_FAST_CALLBACK */
+
+  if ((ctx == NULL) || (ctx->read_reg == NULL))
+  {
+    return -1;
+  }
+
+  val->read_reg = ctx->read_reg;
+  val->handle = ctx->handle;
+  val->cb = cb;
+  val->arg = arg;
+  /* the 5-byte burst relies on register address auto-increment */
+  ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG2, &ctrl_reg2, 1);
+
+  if ((ret == 0) &&
+      (LPS22CH_FIELD_GET(ctrl_reg2, CTRL_REG2, IF_ADD_INC) ==
+       PROPERTY_DISABLE))
+  {
+    ctrl_reg2 = LPS22CH_FIELD_SET(ctrl_reg2, CTRL_REG2, IF_ADD_INC,
+                                  PROPERTY_ENABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG2, &ctrl_reg2, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_read_reg(ctx, LPS22CH_CTRL_REG3, &ctrl_reg3, 1);
+  }
+
+  if ((ret == 0) &&
+      (LPS22CH_FIELD_GET(ctrl_reg3, CTRL_REG3, DRDY) == PROPERTY_DISABLE))
+  {
+    ctrl_reg3 = LPS22CH_FIELD_SET(ctrl_reg3, CTRL_REG3, DRDY,
+                                  PROPERTY_ENABLE);
+    ret = lps22ch_write_reg(ctx, LPS22CH_CTRL_REG3, &ctrl_reg3, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  DRDY interrupt entry: read PRESS_OUT_XL..TEMP_OUT_H in one
+  *         5-byte burst (this also releases DRDY) and deliver pressure
+  *         in 1/4096 hPa and temperature in 1/100 degC to the callback.
+  *
+  * @param  val      fast path handler (see lps22ch_fast_init)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_fast_isr(const lps22ch_fast_t *val)
+{
+  uint8_t buff[5];
+  int32_t press;
+  int16_t temp;
+  int32_t ret;
+
+#ifdef LPS22CH_FAST_READ
+  ret = LPS22CH_FAST_READ(val->handle, LPS22CH_PRESS_OUT_XL, buff, 5U);
+#else
+  ret = val->read_reg(val->handle, LPS22CH_PRESS_OUT_XL, buff, 5U);
+#endif /* LPS22CH_FAST_READ */
+
+  if (ret != 0) { return ret; }
+
+  press = (int32_t)(((uint32_t)buff[2] << 16) |
+                    ((uint32_t)buff[1] << 8) | buff[0]);
+  temp = (int16_t)(buff[3] | ((uint16_t)buff[4] << 8));
+#ifdef LPS22CH_FAST_CALLBACK
+  LPS22CH_FAST_CALLBACK(val->arg, press, temp);
+#else
+  val->cb(val->arg, press, temp);
+#endif /* LPS22CH_FAST_CALLBACK */
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Register_Map
+  * @brief     This section groups the register map descriptor table
+  *            generated from LPS22CH_REG_LIST.
+  * @{
+  *
+  */
+
+#define LPS22CH_REG_DESC(reg, access, reset)                             \
+  { LPS22CH_##reg, (access), (reset) },
+
+const lps22ch_reg_desc_t lps22ch_reg_map[LPS22CH_REG_NUM] =
+{
+  LPS22CH_REG_LIST(LPS22CH_REG_DESC)
+};
+
+/* dispatch table: address - INTERRUPT_CFG -> map index + 1, 0 reserved */
+#define LPS22CH_REG_DISPATCH_SIZE                                          \
+  (LPS22CH_FIFO_DATA_OUT_TEMP_H - LPS22CH_INTERRUPT_CFG + 1U)
+#define LPS22CH_REG_DISPATCH(reg, access, reset)                         \
+  [LPS22CH_##reg - LPS22CH_INTERRUPT_CFG] =                               \
+    (uint8_t)(LPS22CH_REG_IDX_##reg + 1),
+
+static const uint8_t lps22ch_reg_dispatch[LPS22CH_REG_DISPATCH_SIZE] =
+{
+  LPS22CH_REG_LIST(LPS22CH_REG_DISPATCH)
+};
+
+/*
+ * Compile-time checks of the field description: every field belongs to
+ * a register of LPS22CH_REG_LIST and fits in one byte. The register
+ * bit-field structs are hand-written and must stay one byte wide; the
+ * position of their members is not visible to the compiler and is kept
+ * in sync with LPS22CH_FIELD_LIST by hand.
+ */
+#define LPS22CH_FIELD_CHECK(reg, fld, pos, width)                        \
+  typedef char lps22ch_##reg##_##fld##_check                             \
+  [((LPS22CH_REG_IDX_##reg < LPS22CH_REG_NUM) &&                         \
+    (((pos) + (width)) <= 8U)) ? 1 : -1];
+
+LPS22CH_FIELD_LIST(LPS22CH_FIELD_CHECK)
+
+#define LPS22CH_STRUCT_CHECK(type)                                         \
+  typedef char type##_check[(sizeof(type) == 1U) ? 1 : -1];
+
+LPS22CH_STRUCT_CHECK(lps22ch_interrupt_cfg_t)
+LPS22CH_STRUCT_CHECK(lps22ch_ths_p_l_t)
+LPS22CH_STRUCT_CHECK(lps22ch_ths_p_h_t)
+LPS22CH_STRUCT_CHECK(lps22ch_if_ctrl_t)
+LPS22CH_STRUCT_CHECK(lps22ch_ctrl_reg1_t)
+LPS22CH_STRUCT_CHECK(lps22ch_ctrl_reg2_t)
+LPS22CH_STRUCT_CHECK(lps22ch_ctrl_reg3_t)
+LPS22CH_STRUCT_CHECK(lps22ch_fifo_ctrl_t)
+LPS22CH_STRUCT_CHECK(lps22ch_fifo_wtm_t)
+LPS22CH_STRUCT_CHECK(lps22ch_int_source_t)
+LPS22CH_STRUCT_CHECK(lps22ch_fifo_status2_t)
+LPS22CH_STRUCT_CHECK(lps22ch_status_t)
+
+/**
+  * @brief  Register descriptor lookup through the dispatch table.
+  *
+  * @param  reg      register address
+  * @retval          register descriptor, NULL if reserved
+  *
+  */
+const lps22ch_reg_desc_t *lps22ch_reg_desc_get(uint8_t reg)
+{
+  uint8_t idx;
+
+  if ((reg < LPS22CH_INTERRUPT_CFG) || (reg > LPS22CH_FIFO_DATA_OUT_TEMP_H))
+  {
+    return NULL;
+  }
+
+  idx = lps22ch_reg_dispatch[reg - LPS22CH_INTERRUPT_CFG];
+
+  return (idx != 0U) ? &lps22ch_reg_map[idx - 1U] : NULL;
+}
+
+/**
+  * @brief  Register access flags (LPS22CH_REG_R, LPS22CH_REG_W,
+  *         LPS22CH_REG_VOLATILE, LPS22CH_REG_RD_CLEAR).
+  *
+  * @param  reg      register address
+  * @retval          access flags, 0 if reserved
+  *
+  */
+uint8_t lps22ch_reg_access_get(uint8_t reg)
+{
+  const lps22ch_reg_desc_t *desc;
+
+  desc = lps22ch_reg_desc_get(reg);
+
+  return (desc != NULL) ? desc->access : 0U;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Read_Scope
+  * @brief     This section groups the functions that coalesce the
+  *            register reads done by the getters inside a scope.
+  * @{
+  *
+  */
+
+/* widen a read burst over the unknown neighbours that are safe to read */
+static void lps22ch_span_widen(uint64_t known, uint8_t reg, uint16_t len,
+                               uint8_t *first, uint8_t *last)
+{
+  uint64_t span = LPS22CH_PLAN_SPAN_MASK & ~known;
+
+  *first = reg;
+  *last = (uint8_t)(reg + len - 1U);
+
+  while ((*first > 0U) && ((span & LPS22CH_PLAN_REG(*first - 1U)) != 0U))
+  {
+    (*first)--;
+  }
+
+  while (((*last + 1U) < LPS22CH_PLAN_MAP_SIZE) &&
+         ((span & LPS22CH_PLAN_REG(*last + 1U)) != 0U))
+  {
+    (*last)++;
+  }
+}
+
+static int32_t lps22ch_scope_read(void *handle, uint8_t reg, uint8_t *data,
+                                  uint16_t len)
+{
+  lps22ch_scope_t *val = (lps22ch_scope_t *)handle;
+  uint64_t need;
+  uint8_t first;
+  uint8_t last;
+  uint16_t i;
+  int32_t ret;
+
+  if ((len == 0U) || (((uint16_t)reg + len) > LPS22CH_PLAN_MAP_SIZE))
+  {
+    /* FIFO data and out of map: never cached */
+    val->reads++;
+    return val->bus->read_reg(val->bus->handle, reg, data, len);
+  }
+
+  need = (((uint64_t)1U << len) - 1U) << reg;
+
+  if ((val->valid & need) != need)
+  {
+    lps22ch_span_widen(val->valid, reg, len, &first, &last);
+    val->reads++;
+    ret = val->bus->read_reg(val->bus->handle, first, &val->image[first],
+                             (uint16_t)(last - first + 1U));
+
+    if (ret != 0) { return ret; }
+
+    val->valid |= (((uint64_t)1U << (last - first + 1U)) - 1U) << first;
+  }
+
+  else
+  {
+    val->hits++;
+  }
+
+  for (i = 0U; i < len; i++)
+  {
+    data[i] = val->image[reg + i];
+  }
+
+  return 0;
+}
+
+static int32_t lps22ch_scope_write(void *handle, uint8_t reg,
+                                   const uint8_t *data, uint16_t len)
+{
+  lps22ch_scope_t *val = (lps22ch_scope_t *)handle;
+
+  /* a write can change any register (reset, boot, FIFO mode) */
+  val->valid = 0U;
+
+  return val->bus->write_reg(val->bus->handle, reg, data, len);
+}
+
+/**
+  * @brief  Open a read-coalescing scope on ctx. Getters called with
+  *         &val->ctx read each register from the bus once, in bursts
+  *         widened over the neighbouring registers that have no read
+  *         side effect; later reads are served from the scope image.
+  *         Status and output values are a snapshot taken at first
+  *         read. Any write through the scope drops the image.
+  *         lps22ch_read_reg / lps22ch_write_reg must not be overridden.
+  *
+  * @param  val      scope
+  * @param  ctx      read / write interface definitions of the device
+  *
+  */
+void lps22ch_scope_begin(lps22ch_scope_t *val, const stmdev_ctx_t *ctx)
+{
+  val->ctx = *ctx;
+  val->ctx.read_reg = lps22ch_scope_read;
+  val->ctx.write_reg = lps22ch_scope_write;
+  val->ctx.handle = val;
+  val->bus = ctx;
+  val->valid = 0U;
+  val->reads = 0U;
+  val->hits = 0U;
+}
+
+/**
+  * @brief  Close a read-coalescing scope: cached values are dropped,
+  *         &val->ctx keeps working as a pass-through context.
+  *
+  * @param  val      scope
+  *
+  */
+void lps22ch_scope_end(lps22ch_scope_t *val)
+{
+  val->valid = 0U;
+  val->ctx = *val->bus;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Write_Combining
+  * @brief     This section groups the functions that stage the writes
+  *            done by the setters and flush them in a few bursts.
+  * @{
+  *
+  */
+
+/* registers that can be staged */
+#define LPS22CH_STAGE_W_BIT(reg, access, reset)                           \
+  LPS22CH_REG_BIT_IF(reg, ((access) & LPS22CH_REG_W) != 0U)
+#define LPS22CH_STAGE_W_MASK                                                \
+  ((uint64_t)0U LPS22CH_REG_LIST(LPS22CH_STAGE_W_BIT))
+
+/* registers whose known value can be rewritten as burst filler */
+#define LPS22CH_STAGE_FILL_BIT(reg, access, reset)                        \
+  LPS22CH_REG_BIT_IF(reg, ((access) & (LPS22CH_REG_W |                   \
+                                       LPS22CH_REG_VOLATILE)) ==          \
+                          LPS22CH_REG_W)
+#define LPS22CH_STAGE_FILL_MASK                                             \
+  ((uint64_t)0U LPS22CH_REG_LIST(LPS22CH_STAGE_FILL_BIT))
+
+static uint64_t lps22ch_stage_range(uint8_t reg, uint16_t len)
+{
+  return (((uint64_t)1U << len) - 1U) << reg;
+}
+
+static int32_t lps22ch_stage_read(void *handle, uint8_t reg, uint8_t *data,
+                                  uint16_t len)
+{
+  lps22ch_stage_t *val = (lps22ch_stage_t *)handle;
+  uint8_t buff[LPS22CH_PLAN_MAP_SIZE];
+  uint64_t known;
+  uint64_t need;
+  uint64_t bit;
+  uint8_t first;
+  uint8_t last;
+  uint16_t i;
+  int32_t ret;
+
+  if ((len == 0U) || (((uint16_t)reg + len) > LPS22CH_PLAN_MAP_SIZE))
+  {
+    return val->bus->read_reg(val->bus->handle, reg, data, len);
+  }
+
+  need = lps22ch_stage_range(reg, len);
+  known = val->valid | val->dirty;
+
+  if ((known & need) != need)
+  {
+    lps22ch_span_widen(known, reg, len, &first, &last);
+    ret = val->bus->read_reg(val->bus->handle, first, &buff[first],
+                             (uint16_t)(last - first + 1U));
+
+    if (ret != 0) { return ret; }
+
+    for (i = first; i <= last; i++)
+    {
+      bit = LPS22CH_PLAN_REG(i);
+
+      if ((val->dirty & bit) == 0U)
+      {
+        /* only non volatile writable registers are remembered */
+        val->image[i] = buff[i];
+        val->valid |= bit & LPS22CH_STAGE_FILL_MASK;
+      }
+    }
+  }
+
+  /* staged values win over the device */
+  for (i = 0U; i < len; i++)
+  {
+    data[i] = val->image[reg + i];
+  }
+
+  return 0;
+}
+
+/* self-clearing command bits (reset, boot, one-shot) written by data */
+static uint8_t lps22ch_stage_command(uint8_t reg, const uint8_t *data,
+                                     uint16_t len)
+{
+  uint8_t cmd = 0U;
+
+  if ((reg <= LPS22CH_CTRL_REG2) &&
+      (((uint16_t)reg + len) > LPS22CH_CTRL_REG2))
+  {
+    cmd = data[LPS22CH_CTRL_REG2 - reg] &
+          (uint8_t)(LPS22CH_CTRL_REG2_SWRESET_MSK |
+                    LPS22CH_CTRL_REG2_BOOT_MSK |
+                    LPS22CH_CTRL_REG2_ONE_SHOT_MSK);
+  }
+
+  return cmd;
+}
+
+static int32_t lps22ch_stage_write(void *handle, uint8_t reg,
+                                   const uint8_t *data, uint16_t len)
+{
+  lps22ch_stage_t *val = (lps22ch_stage_t *)handle;
+  uint64_t range;
+  uint16_t i;
+  int32_t ret;
+
+  if ((len == 0U) || (((uint16_t)reg + len) > LPS22CH_PLAN_MAP_SIZE) ||
+      ((lps22ch_stage_range(reg, len) & ~LPS22CH_STAGE_W_MASK) != 0U) ||
+      (lps22ch_stage_command(reg, data, len) != 0U))
+  {
+    /* not stageable or command: keep the program order */
+    ret = lps22ch_flush(val);
+
+    if (ret == 0)
+    {
+      val->writes++;
+      ret = val->bus->write_reg(val->bus->handle, reg, data, len);
+    }
+
+    if (lps22ch_stage_command(reg, data, len) != 0U)
+    {
+      /* reset and boot reload the registers */
+      val->valid = 0U;
+    }
+
+    return ret;
+  }
+
+  range = lps22ch_stage_range(reg, len);
+
+  for (i = 0U; i < len; i++)
+  {
+    val->image[reg + i] = data[i];
+  }
+
+  val->dirty |= range;
+
+  return 0;
+}
+
+static int32_t lps22ch_stage_write_mask(lps22ch_stage_t *val, uint64_t mask)
+{
+  uint64_t fill;
+  uint64_t span;
+  uint8_t first;
+  uint8_t last;
+  uint8_t reg;
+  int32_t ret = 0;
+
+  /* staged registers outside mask must keep their turn */
+  fill = val->valid & LPS22CH_STAGE_FILL_MASK & ~(val->dirty & ~mask);
+  reg = 0U;
+
+  while ((ret == 0) && (reg < LPS22CH_PLAN_MAP_SIZE))
+  {
+    if ((mask & LPS22CH_PLAN_REG(reg)) == 0U)
+    {
+      reg++;
+      continue;
+    }
+
+    /* extend the burst over staged and known registers */
+    first = reg;
+    last = reg;
+    reg++;
+
+    while ((reg < LPS22CH_PLAN_MAP_SIZE) &&
+           (((mask | fill) & LPS22CH_PLAN_REG(reg)) != 0U))
+    {
+      if ((mask & LPS22CH_PLAN_REG(reg)) != 0U)
+      {
+        last = reg;
+      }
+
+      reg++;
+    }
+
+    val->writes++;
+    ret = val->bus->write_reg(val->bus->handle, first, &val->image[first],
+                              (uint16_t)(last - first + 1U));
+
+    if (ret == 0)
+    {
+      span = lps22ch_stage_range(first, (uint16_t)(last - first + 1U));
+      val->dirty &= ~span;
+      val->valid |= span & LPS22CH_STAGE_FILL_MASK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Open a write-combining stage on ctx. Setters called with
+  *         &val->ctx only update a staged register image (reads are
+  *         served from it when known) until lps22ch_flush is called.
+  *         Writes to registers that cannot be staged and writes of
+  *         command bits (SWRESET, BOOT, ONE_SHOT) flush first, then
+  *         go straight to the device.
+  *         lps22ch_read_reg / lps22ch_write_reg must not be overridden.
+  *
+  * @param  val      stage
+  * @param  ctx      read / write interface definitions of the device
+  *
+  */
+void lps22ch_stage_begin(lps22ch_stage_t *val, const stmdev_ctx_t *ctx)
+{
+  val->ctx = *ctx;
+  val->ctx.read_reg = lps22ch_stage_read;
+  val->ctx.write_reg = lps22ch_stage_write;
+  val->ctx.handle = val;
+  val->bus = ctx;
+  val->valid = 0U;
+  val->dirty = 0U;
+  val->writes = 0U;
+}
+
+/**
+  * @brief  Write all staged registers with the fewest bursts: gaps are
+  *         filled with known non volatile registers. When FIFO_CTRL
+  *         is staged, FIFO_WTM is written first so that the new FIFO
+  *         mode starts with the new watermark.
+  *
+  * @param  val      stage
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_flush(lps22ch_stage_t *val)
+{
+  uint64_t early = 0U;
+  int32_t ret = 0;
+
+  if ((val->dirty & LPS22CH_PLAN_REG(LPS22CH_FIFO_CTRL)) != 0U)
+  {
+    early = val->dirty & LPS22CH_PLAN_REG(LPS22CH_FIFO_WTM);
+  }
+
+  if (early != 0U)
+  {
+    ret = lps22ch_stage_write_mask(val, early);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_stage_write_mask(val, val->dirty);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Register_Snapshot
+  * @brief     This section groups the functions that read, compare and
+  *            restore the whole register map.
+  * @{
+  *
+  */
+
+/* byte of val holding register reg, NULL if reserved */
+static const uint8_t *lps22ch_regmap_byte(const lps22ch_regmap_t *val,
+                                          uint8_t reg)
+{
+  const uint8_t *byte = NULL;
+
+  if ((reg >= LPS22CH_INTERRUPT_CFG) && (reg <= LPS22CH_REF_P_H))
+  {
+    byte = &val->ctrl[reg - LPS22CH_INTERRUPT_CFG];
+  }
+
+  else if ((reg >= LPS22CH_RPDS_L) && (reg <= LPS22CH_RPDS_H))
+  {
+    byte = &val->rpds[reg - LPS22CH_RPDS_L];
+  }
+
+  else if ((reg >= LPS22CH_INT_SOURCE) && (reg <= LPS22CH_TEMP_OUT_H))
+  {
+    byte = &val->out[reg - LPS22CH_INT_SOURCE];
+  }
+
+  else
+  {
+    /* reserved */
+  }
+
+  return byte;
+}
+
+/**
+  * @brief  Read the readable register map in three bursts (reserved
+  *         addresses skipped). Reading clears latched interrupts and
+  *         data-ready flags: their values are kept in val->out.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      register map snapshot
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_regmap_snapshot(const stmdev_ctx_t *ctx,
+                                lps22ch_regmap_t *val)
+{
+  int32_t ret;
+
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, val->ctrl, 12);
+
+  if (ret == 0)
+  {
+    ret = lps22ch_read_reg(ctx, LPS22CH_RPDS_L, val->rpds, 2);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps22ch_read_reg(ctx, LPS22CH_INT_SOURCE, val->out, 9);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Build the expected register map of a configuration image.
+  *         Output registers are zeroed, compare with
+  *         LPS22CH_REGMAP_CFG_MASK.
+  *
+  * @param  cfg      configuration image
+  * @param  val      expected register map
+  *
+  */
+void lps22ch_regmap_from_cfg(const lps22ch_cfg_t *cfg,
+                             lps22ch_regmap_t *val)
+{
+  uint8_t i;
+
+  val->ctrl[0] = *(const uint8_t *) & (cfg->interrupt_cfg);
+  val->ctrl[1] = *(const uint8_t *) & (cfg->ths_p_l);
+  val->ctrl[2] = *(const uint8_t *) & (cfg->ths_p_h);
+  val->ctrl[3] = *(const uint8_t *) & (cfg->if_ctrl);
+  val->ctrl[4] = LPS22CH_ID;
+  val->ctrl[5] = *(const uint8_t *) & (cfg->ctrl_reg1);
+  val->ctrl[6] = *(const uint8_t *) & (cfg->ctrl_reg2);
+  val->ctrl[6] = LPS22CH_FIELD_SET(val->ctrl[6], CTRL_REG2, SWRESET, 0U);
+  val->ctrl[6] = LPS22CH_FIELD_SET(val->ctrl[6], CTRL_REG2, BOOT, 0U);
+  val->ctrl[7] = *(const uint8_t *) & (cfg->ctrl_reg3);
+  val->ctrl[8] = *(const uint8_t *) & (cfg->fifo_ctrl);
+  val->ctrl[9] = *(const uint8_t *) & (cfg->fifo_wtm);
+  val->ctrl[10] = (uint8_t)((uint16_t)cfg->ref_p & 0xFFU);
+  val->ctrl[11] = (uint8_t)((uint16_t)cfg->ref_p >> 8);
+  val->rpds[0] = (uint8_t)((uint16_t)cfg->rpds & 0xFFU);
+  val->rpds[1] = (uint8_t)((uint16_t)cfg->rpds >> 8);
+
+  for (i = 0U; i < 9U; i++)
+  {
+    val->out[i] = 0U;
+  }
+}
+
+/**
+  * @brief  Compare two register map snapshots.
+  *
+  * @param  val      register map snapshot
+  * @param  ref      reference (snapshot or lps22ch_regmap_from_cfg)
+  * @param  mask     LPS22CH_PLAN_REG() of the registers to compare
+  * @retval          LPS22CH_PLAN_REG() of the registers that differ
+  *
+  */
+uint64_t lps22ch_regmap_diff(const lps22ch_regmap_t *val,
+                             const lps22ch_regmap_t *ref, uint64_t mask)
+{
+  const uint8_t *a;
+  const uint8_t *b;
+  uint64_t diff = 0U;
+  uint8_t reg;
+
+  for (reg = 0U; reg < LPS22CH_PLAN_MAP_SIZE; reg++)
+  {
+    if ((mask & LPS22CH_PLAN_REG(reg)) == 0U)
+    {
+      continue;
+    }
+
+    a = lps22ch_regmap_byte(val, reg);
+    b = lps22ch_regmap_byte(ref, reg);
+
+    if ((a != NULL) && (*a != *b))
+    {
+      diff |= LPS22CH_PLAN_REG(reg);
+    }
+  }
+
+  return diff;
+}
+
+/**
+  * @brief  Write back only the registers that differ, in the fewest
+  *         bursts (see lps22ch_flush). Registers outside diff are
+  *         assumed to hold their value in val and may be rewritten as
+  *         burst filler. Read-only registers in diff are ignored.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      expected register map
+  * @param  diff     lps22ch_regmap_diff(snapshot, val, mask)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_regmap_reapply(const stmdev_ctx_t *ctx,
+                               const lps22ch_regmap_t *val, uint64_t diff)
+{
+  lps22ch_stage_t stage;
+  const uint8_t *byte;
+  uint64_t known = 0U;
+  uint8_t reg;
+
+  lps22ch_stage_begin(&stage, ctx);
+
+  for (reg = 0U; reg < LPS22CH_PLAN_MAP_SIZE; reg++)
+  {
+    byte = lps22ch_regmap_byte(val, reg);
+
+    if (byte != NULL)
+    {
+      stage.image[reg] = *byte;
+      known |= LPS22CH_PLAN_REG(reg);
+    }
+  }
+
+  /* never replay self-clearing commands */
+  stage.image[LPS22CH_CTRL_REG2] =
+    LPS22CH_FIELD_SET(stage.image[LPS22CH_CTRL_REG2], CTRL_REG2, SWRESET, 0U);
+  stage.image[LPS22CH_CTRL_REG2] =
+    LPS22CH_FIELD_SET(stage.image[LPS22CH_CTRL_REG2], CTRL_REG2, BOOT, 0U);
+  stage.image[LPS22CH_CTRL_REG2] =
+    LPS22CH_FIELD_SET(stage.image[LPS22CH_CTRL_REG2], CTRL_REG2, ONE_SHOT,
+                      0U);
+  stage.valid = known & ~diff & LPS22CH_STAGE_FILL_MASK;
+  stage.dirty = known & diff & LPS22CH_STAGE_W_MASK;
+
+  return lps22ch_flush(&stage);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Brown_Out_Recovery
+  * @brief     This section groups the functions that detect a device
+  *            reboot and restore the last known configuration without
+  *            a full initialization.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Set the configuration to restore after a reboot. Call it
+  *         again whenever the configuration changes.
+  *
+  * @param  val      recovery handler
+  * @param  cfg      configuration image (see lps22ch_cfg_set)
+  *
+  */
+void lps22ch_recover_init(lps22ch_recover_t *val, const lps22ch_cfg_t *cfg)
+{
+  val->cfg = *cfg;
+  val->checks = 0U;
+  val->reboots = 0U;
+}
+
+/**
+  * @brief  Detect a reboot with a single read of INTERRUPT_CFG..REF_P_H:
+  *         the device rebooted if the configuration registers no
+  *         longer match the cached image (command bits, WHO_AM_I and
+  *         REF_P are ignored). While the boot is still running
+  *         (BOOT bit set) no reboot is reported yet.
+  *         A set boot_on flag in INT_SOURCE, read by the application,
+  *         can go straight to lps22ch_recover_restore.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      recovery handler
+  * @param  rebooted 1: configuration lost, call lps22ch_recover_restore
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_recover_check(const stmdev_ctx_t *ctx,
+                              lps22ch_recover_t *val, uint8_t *rebooted)
+{
+  lps22ch_regmap_t exp;
+  uint8_t buff[12];
+  uint8_t i;
+  int32_t ret;
+
+  *rebooted = 0U;
+  val->checks++;
+  ret = lps22ch_read_reg(ctx, LPS22CH_INTERRUPT_CFG, buff, 12);
+
+  if (ret != 0) { return ret; }
+
+  if (LPS22CH_FIELD_GET(buff[LPS22CH_CTRL_REG2 - LPS22CH_INTERRUPT_CFG],
+                        CTRL_REG2, BOOT) != 0U)
+  {
+    return ret;
+  }
+
+  lps22ch_regmap_from_cfg(&val->cfg, &exp);
+  /* command bits self-clear, they are not configuration */
+  buff[0] &= (uint8_t)~(LPS22CH_INTERRUPT_CFG_RESET_AZ_MSK |
+                        LPS22CH_INTERRUPT_CFG_RESET_ARP_MSK);
+  exp.ctrl[0] &= (uint8_t)~(LPS22CH_INTERRUPT_CFG_RESET_AZ_MSK |
+                            LPS22CH_INTERRUPT_CFG_RESET_ARP_MSK);
+  buff[LPS22CH_CTRL_REG2 - LPS22CH_INTERRUPT_CFG] &=
+    (uint8_t)~LPS22CH_CTRL_REG2_ONE_SHOT_MSK;
+  exp.ctrl[LPS22CH_CTRL_REG2 - LPS22CH_INTERRUPT_CFG] &=
+    (uint8_t)~LPS22CH_CTRL_REG2_ONE_SHOT_MSK;
+
+  /* INTERRUPT_CFG..FIFO_WTM, except WHO_AM_I */
+  for (i = 0U; i <= (LPS22CH_FIFO_WTM - LPS22CH_INTERRUPT_CFG); i++)
+  {
+    if ((i != (LPS22CH_WHO_AM_I - LPS22CH_INTERRUPT_CFG)) &&
+        (buff[i] != exp.ctrl[i]))
+    {
+      *rebooted = 1U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Restore the cached configuration, REF_P / RPDS offsets and
+  *         FIFO setup included, without identification or reset
+  *         handshake (see lps22ch_cfg_set). The FIFO restarts empty:
+  *         the stream, if any, reports a gap on its next batch.
+  *         With AUTOREFP or AUTOZERO in the cached INTERRUPT_CFG, the
+  *         image is first written with both masked so that the ODR
+  *         starts; they are then enabled again, the conversion that
+  *         loads REF_P is awaited and the cached REF_P is written and
+  *         read back (as lps22ch_ths_mon_set does), which needs
+  *         ctx->mdelay: without it -1 is returned after the plain
+  *         restore. In power-down / one-shot mode the image is written
+  *         as is and REF_P is reloaded at the next conversion.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      recovery handler
+  * @param  stream   stream handler to resume (NULL if none)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22ch_recover_restore(const stmdev_ctx_t *ctx,
+                                lps22ch_recover_t *val,
+                                lps22ch_stream_t *stream)
+{
+  lps22ch_cfg_t cfg;
+  uint32_t period;
+  uint8_t auto_ref;
+  uint8_t odr;
+  uint8_t reg;
+  int32_t ret;
+
+  val->reboots++;
+  cfg = val->cfg;
+  reg = *(uint8_t *) & (cfg.interrupt_cfg);
+  auto_ref = reg & (uint8_t)(LPS22CH_INTERRUPT_CFG_AUTOREFP_MSK |
+                             LPS22CH_INTERRUPT_CFG_AUTOZERO_MSK);
+  odr = LPS22CH_FIELD_GET(*(uint8_t *) & (cfg.ctrl_reg1), CTRL_REG1, ODR);
+  /* 0 in power-down and one-shot mode */
+  period = lps22ch_sample_time_ms_get((lps22ch_odr_t)odr);
+
+  if ((auto_ref == 0U) || (period == 0U))
+  {
+    ret = lps22ch_cfg_set(ctx, &cfg);
+  }
+
+  else if (ctx->mdelay == NULL)
+  {
+    ret = lps22ch_cfg_set(ctx, &cfg);
+
+    if (ret == 0)
+    {
+      ret = -1;
+    }
+  }
+
+  else
+  {
+    /* REF_P written by cfg_set survives until AUTOREFP / AUTOZERO */
+    *(uint8_t *) & (cfg.interrupt_cfg) = reg & (uint8_t)~auto_ref;
+    ret = lps22ch_cfg_set(ctx, &cfg);
+
+    if (ret == 0)
+    {
+      ret = lps22ch_write_reg(ctx, LPS22CH_INTERRUPT_CFG, &reg, 1);
+    }
+
+    if (ret == 0)
+    {
+      ret = lps22ch_ref_p_load_wait(ctx, period);
+    }
+
+    if (ret == 0)
+    {
+      ret = lps22ch_ref_p_check_set(ctx, cfg.ref_p);
+    }
+  }
+
+  if (stream != NULL)
+  {
+    stream->level = 0U;
+    stream->ovr = 1U;
+    stream->gaps++;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LPS22CH_Discovery
+  * @brief     This section groups the functions that discover the
+  *            devices connected on several buses and mux channels.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Probe every mux channel and both I2C addresses of a bus.
+  *         Each channel is selected once and both addresses are probed
+  *         before switching. The function keeps no state: one worker
+  *         per bus can run it concurrently on different buses.
+  *         The platform handle of a device must select its mux
+  *         channel when it is used after discovery.
+  *
+  * @param  bus      bus description
+  * @param  bus_id   bus identifier stored in found
+  * @param  found    devices answering LPS22CH_ID
+  * @param  max      size of found
+  * @param  num      number of devices found
+  * @retval          mux status (MANDATORY: return 0 -> no Error),
+  *                  -1 found is full
+  *
+  */
+int32_t lps22ch_discover_bus(const lps22ch_bus_t *bus, uint8_t bus_id,
+                             lps22ch_found_t *found, uint8_t max,
+                             uint8_t *num)
+{
+  const uint8_t address[2] = { LPS22CH_I2C_ADD_L, LPS22CH_I2C_ADD_H };
+  stmdev_ctx_t ctx;
+  uint8_t channels;
+  uint8_t ch;
+  uint8_t i;
+  uint8_t id;
+  int32_t ret = 0;
+
+  *num = 0U;
+  channels = (bus->mux_channels > 0U) ? bus->mux_channels : 1U;
+
+  for (ch = 0U; (ret == 0) && (ch < channels); ch++)
+  {
+    if (bus->mux_select != NULL)
+    {
+      ret = bus->mux_select(bus->bus, ch);
+
+      if (ret != 0) { break; }
+    }
+
+    for (i = 0U; i < 2U; i++)
+    {
+      ctx = bus->ctx;
+      ctx.handle = bus->handle_get(bus->bus, ch, address[i]);
+
+      /* a bus error means nobody answered */
+      if ((lps22ch_device_id_get(&ctx, &id) != 0) || (id != LPS22CH_ID))
+      {
+        continue;
+      }
+
+      if (*num >= max)
+      {
+        ret = -1;
+        break;
+      }
+
+      found[*num].ctx = ctx;
+      found[*num].bus = bus_id;
+      found[*num].channel = ch;
+      found[*num].address = address[i];
+      (*num)++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Probe all buses one after the other (single thread
+  *         platforms). Multi-thread platforms should run
+  *         lps22ch_discover_bus on each bus in its own worker.
+  *
+  * @param  bus      bus descriptions
+  * @param  num_bus  number of buses
+  * @param  found    devices answering LPS22CH_ID
+  * @param  max      size of found
+  * @param  num      number of devices found
+  * @retval          mux status (MANDATORY: return 0 -> no Error),
+  *                  -1 found is full
+  *
+  */
+int32_t lps22ch_discover(const lps22ch_bus_t *bus, uint8_t num_bus,
+                         lps22ch_found_t *found, uint8_t max,
+                         uint8_t *num)
+{
+  uint8_t b;
+  uint8_t n;
+  int32_t ret = 0;
+
+  *num = 0U;
+
+  for (b = 0U; (ret == 0) && (b < num_bus); b++)
+  {
+    ret = lps22ch_discover_bus(&bus[b], b, &found[*num], max - *num, &n);
+    *num += n;
+  }
 
   return ret;
 }
@@ -413,6 +413,178 @@ typedef struct
 #define LPS22CH_FIFO_DATA_OUT_TEMP_L            0x7BU
 #define LPS22CH_FIFO_DATA_OUT_TEMP_H            0x7CU
 
+/**
+  * @defgroup LPS22CH_Register_Map
+  * @brief    Machine-readable register map: X(register, access, reset).
+  *           The address is LPS22CH_<register>. Access flags tell the
+  *           caching and batching layers which registers can be
+  *           shadowed, written and read as burst filler.
+  * @{
+  *
+  */
+
+#define LPS22CH_REG_R                           0x01U /* readable */
+#define LPS22CH_REG_W                           0x02U /* writable */
+#define LPS22CH_REG_VOLATILE                    0x04U /* set by device */
+#define LPS22CH_REG_RD_CLEAR                    0x08U /* read side effect */
+#define LPS22CH_REG_RO                          (LPS22CH_REG_R)
+#define LPS22CH_REG_RW                          (LPS22CH_REG_R | LPS22CH_REG_W)
+
+#define LPS22CH_REG_LIST(X) \
+  X(INTERRUPT_CFG,             LPS22CH_REG_RW,                  0x00U) \
+  X(THS_P_L,                   LPS22CH_REG_RW,                  0x00U) \
+  X(THS_P_H,                   LPS22CH_REG_RW,                  0x00U) \
+  X(IF_CTRL,                   LPS22CH_REG_RW,                  0x00U) \
+  X(WHO_AM_I,                  LPS22CH_REG_RO,                  LPS22CH_ID) \
+  X(CTRL_REG1,                 LPS22CH_REG_RW,                  0x00U) \
+  X(CTRL_REG2,                 LPS22CH_REG_RW | LPS22CH_REG_VOLATILE, 0x10U) \
+  X(CTRL_REG3,                 LPS22CH_REG_RW,                  0x00U) \
+  X(FIFO_CTRL,                 LPS22CH_REG_RW,                  0x00U) \
+  X(FIFO_WTM,                  LPS22CH_REG_RW,                  0x00U) \
+  X(REF_P_L,                   LPS22CH_REG_RW | LPS22CH_REG_VOLATILE, 0x00U) \
+  X(REF_P_H,                   LPS22CH_REG_RW | LPS22CH_REG_VOLATILE, 0x00U) \
+  X(RPDS_L,                    LPS22CH_REG_RW,                  0x00U) \
+  X(RPDS_H,                    LPS22CH_REG_RW,                  0x00U) \
+  X(INT_SOURCE,                LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_STATUS1,              LPS22CH_REG_RO | LPS22CH_REG_VOLATILE, 0x00U) \
+  X(FIFO_STATUS2,              LPS22CH_REG_RO | LPS22CH_REG_VOLATILE, 0x00U) \
+  X(STATUS,                    LPS22CH_REG_RO | LPS22CH_REG_VOLATILE, 0x00U) \
+  X(PRESS_OUT_XL,              LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(PRESS_OUT_L,               LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(PRESS_OUT_H,               LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(TEMP_OUT_L,                LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(TEMP_OUT_H,                LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_DATA_OUT_PRESS_XL,    LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_DATA_OUT_PRESS_L,     LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_DATA_OUT_PRESS_H,     LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_DATA_OUT_TEMP_L,      LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U) \
+  X(FIFO_DATA_OUT_TEMP_H,      LPS22CH_REG_RO | LPS22CH_REG_VOLATILE | \
+                               LPS22CH_REG_RD_CLEAR,            0x00U)
+
+#define LPS22CH_REG_INDEX(reg, access, reset)  LPS22CH_REG_IDX_##reg,
+
+typedef enum
+{
+  LPS22CH_REG_LIST(LPS22CH_REG_INDEX)
+  LPS22CH_REG_NUM
+} lps22ch_reg_idx_t;
+
+typedef struct
+{
+  uint8_t address;
+  uint8_t access;
+  uint8_t reset;
+} lps22ch_reg_desc_t;
+
+extern const lps22ch_reg_desc_t lps22ch_reg_map[LPS22CH_REG_NUM];
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LPS22CH_Register_Fields
+  * @brief    Machine-readable description of the register fields:
+  *           X(register, field, position, width).
+  *           It generates the LPS22CH_<register>_<field>_POS / _MSK
+  *           constants used by the mask/shift accessors below, which
+  *           do not depend on compiler bit-field layout.
+  * @{
+  *
+  */
+
+#define LPS22CH_FIELD_LIST(X) \
+  X(INTERRUPT_CFG, PE,           0U, 2U) \
+  X(INTERRUPT_CFG, LIR,          2U, 1U) \
+  X(INTERRUPT_CFG, DIFF_EN,      3U, 1U) \
+  X(INTERRUPT_CFG, RESET_AZ,     4U, 1U) \
+  X(INTERRUPT_CFG, AUTOZERO,     5U, 1U) \
+  X(INTERRUPT_CFG, RESET_ARP,    6U, 1U) \
+  X(INTERRUPT_CFG, AUTOREFP,     7U, 1U) \
+  X(THS_P_L,       THS,          0U, 8U) \
+  X(THS_P_H,       THS,          0U, 7U) \
+  X(IF_CTRL,       I2C_DISABLE,  0U, 1U) \
+  X(IF_CTRL,       I3C_DISABLE,  1U, 1U) \
+  X(IF_CTRL,       PD_DIS_INT1,  2U, 1U) \
+  X(IF_CTRL,       SDO_PU_EN,    3U, 1U) \
+  X(IF_CTRL,       SDA_PU_EN,    4U, 1U) \
+  X(IF_CTRL,       INT_EN_I3C,   7U, 1U) \
+  X(CTRL_REG1,     SIM,          0U, 1U) \
+  X(CTRL_REG1,     BDU,          1U, 1U) \
+  X(CTRL_REG1,     LPFP_CFG,     2U, 2U) \
+  X(CTRL_REG1,     ODR,          4U, 3U) \
+  X(CTRL_REG2,     ONE_SHOT,     0U, 1U) \
+  X(CTRL_REG2,     LOW_NOISE_EN, 1U, 1U) \
+  X(CTRL_REG2,     SWRESET,      2U, 1U) \
+  X(CTRL_REG2,     IF_ADD_INC,   4U, 1U) \
+  X(CTRL_REG2,     PP_OD,        5U, 1U) \
+  X(CTRL_REG2,     INT_H_L,      6U, 1U) \
+  X(CTRL_REG2,     BOOT,         7U, 1U) \
+  X(CTRL_REG3,     INT_S,        0U, 2U) \
+  X(CTRL_REG3,     DRDY,         2U, 1U) \
+  X(CTRL_REG3,     INT_F_OVR,    3U, 1U) \
+  X(CTRL_REG3,     INT_F_WTM,    4U, 1U) \
+  X(CTRL_REG3,     INT_F_FULL,   5U, 1U) \
+  X(FIFO_CTRL,     F_MODE,       0U, 3U) \
+  X(FIFO_CTRL,     STOP_ON_WTM,  3U, 1U) \
+  X(FIFO_WTM,      WTM,          0U, 7U) \
+  X(INT_SOURCE,    PH,           0U, 1U) \
+  X(INT_SOURCE,    PL,           1U, 1U) \
+  X(INT_SOURCE,    IA,           2U, 1U) \
+  X(INT_SOURCE,    BOOT_ON,      7U, 1U) \
+  X(FIFO_STATUS2,  FIFO_FULL_IA, 5U, 1U) \
+  X(FIFO_STATUS2,  FIFO_OVR_IA,  6U, 1U) \
+  X(FIFO_STATUS2,  FIFO_WTM_IA,  7U, 1U) \
+  X(STATUS,        P_DA,         0U, 1U) \
+  X(STATUS,        T_DA,         1U, 1U) \
+  X(STATUS,        P_OR,         4U, 1U) \
+  X(STATUS,        T_OR,         5U, 1U)
+
+#define LPS22CH_FIELD_ENUM(reg, fld, pos, width)                         \
+  LPS22CH_##reg##_##fld##_POS = (pos),                                  \
+  LPS22CH_##reg##_##fld##_MSK = (((1U << (width)) - 1U) << (pos)),
+
+enum
+{
+  LPS22CH_FIELD_LIST(LPS22CH_FIELD_ENUM)
+};
+
+static inline uint8_t lps22ch_field_get(uint8_t reg, uint8_t msk,
+                                        uint8_t pos)
+{
+  return (uint8_t)((reg & msk) >> pos);
+}
+
+static inline uint8_t lps22ch_field_set(uint8_t reg, uint8_t msk,
+                                        uint8_t pos, uint8_t val)
+{
+  return (uint8_t)((reg & (uint8_t)~msk) | ((uint8_t)(val << pos) & msk));
+}
+
+/** Read / update field fld of register reg in the register value byte **/
+#define LPS22CH_FIELD_GET(byte, reg, fld)                                \
+  lps22ch_field_get((byte), LPS22CH_##reg##_##fld##_MSK,                \
+                    LPS22CH_##reg##_##fld##_POS)
+#define LPS22CH_FIELD_SET(byte, reg, fld, val)                           \
+  lps22ch_field_set((byte), LPS22CH_##reg##_##fld##_MSK,                \
+                    LPS22CH_##reg##_##fld##_POS, (uint8_t)(val))
+
+/**
+  * @}
+  *
+  */
+
 /**
   * @defgroup LPS22CH_Register_Union
   * @brief    This union group all the registers having a bit-field
@@ -470,6 +642,10 @@ float_t lps22ch_from_lsb_to_hpa(uint32_t lsb);
 
 float_t lps22ch_from_lsb_to_celsius(int16_t lsb);
 
+int16_t lps22ch_from_hpa_to_ref(float_t hpa);
+
+uint16_t lps22ch_from_hpa_to_ths(float_t hpa);
+
 int32_t lps22ch_autozero_rst_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lps22ch_autozero_rst_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
@@ -538,9 +714,44 @@ int32_t lps22ch_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *buff);
 int32_t lps22ch_fifo_pressure_raw_get(const stmdev_ctx_t *ctx,
                                       uint32_t *buff);
 
+typedef struct
+{
+  lps22ch_status_t        status;
+  uint32_t                press_raw;
+  int16_t                 temp_raw;
+} lps22ch_data_t;
+int32_t lps22ch_data_get(const stmdev_ctx_t *ctx, lps22ch_data_t *val);
+
+typedef enum
+{
+  LPS22CH_RES_PRESS_24BIT       = 0,  /* PRESS_OUT_XL..H (3 byte) */
+  LPS22CH_RES_PRESS_16BIT       = 1,  /* PRESS_OUT_L..H (2 byte) */
+  LPS22CH_RES_PRESS_24BIT_TEMP  = 2,  /* PRESS_OUT_XL..TEMP_OUT_H (5 byte) */
+  LPS22CH_RES_PRESS_16BIT_TEMP  = 3,  /* PRESS_OUT_L..TEMP_OUT_H (4 byte) */
+} lps22ch_res_t;
+int32_t lps22ch_data_res_get(const stmdev_ctx_t *ctx, lps22ch_res_t res,
+                             uint32_t *press, int16_t *temp);
+
 int32_t lps22ch_fifo_temperature_raw_get(const stmdev_ctx_t *ctx,
                                          int16_t *buff);
 
+/** FIFO record as stored by the device: PRESS_XL..PRESS_H, TEMP_L..TEMP_H **/
+#define LPS22CH_FIFO_RECORD_LEN                 5U
+#define LPS22CH_FIFO_DEPTH                      128U
+
+typedef struct
+{
+  uint8_t press[3];
+  uint8_t temp[2];
+} lps22ch_fifo_record_t;
+int32_t lps22ch_fifo_record_get(const stmdev_ctx_t *ctx,
+                                lps22ch_fifo_record_t *buff, uint8_t num);
+void lps22ch_fifo_record_decode(const lps22ch_fifo_record_t *rec,
+                                uint32_t *press, int16_t *temp);
+void lps22ch_fifo_record_convert(const lps22ch_fifo_record_t *rec,
+                                 float_t *hpa, float_t *deg_c,
+                                 uint32_t num);
+
 int32_t lps22ch_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lps22ch_reset_set(const stmdev_ctx_t *ctx, uint8_t val);
@@ -694,6 +905,467 @@ int32_t lps22ch_fifo_threshold_on_int_get(const stmdev_ctx_t *ctx,
 int32_t lps22ch_fifo_full_on_int_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lps22ch_fifo_full_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+/** Worst-case conversion time of a single measurement (ms) **/
+#define LPS22CH_CONV_TIME_LOW_CURRENT_MS        5U
+#define LPS22CH_CONV_TIME_LOW_NOISE_MS          14U
+
+uint32_t lps22ch_sample_time_ms_get(lps22ch_odr_t val);
+
+typedef enum
+{
+  LPS22CH_ONE_SHOT_IDLE  = 0,
+  LPS22CH_ONE_SHOT_WAIT  = 1,
+  LPS22CH_ONE_SHOT_DONE  = 2,
+} lps22ch_one_shot_state_t;
+
+typedef struct
+{
+  uint8_t                   ctrl_reg2; /* CTRL_REG2 image */
+  lps22ch_one_shot_state_t  state;
+  uint32_t                  wait_ms;
+} lps22ch_one_shot_t;
+int32_t lps22ch_one_shot_init(const stmdev_ctx_t *ctx,
+                              lps22ch_one_shot_t *val, uint8_t low_noise);
+int32_t lps22ch_one_shot_start(const stmdev_ctx_t *ctx,
+                               lps22ch_one_shot_t *val, uint32_t *wait_ms);
+int32_t lps22ch_one_shot_poll(const stmdev_ctx_t *ctx,
+                              lps22ch_one_shot_t *val, uint32_t elapsed_ms,
+                              lps22ch_data_t *data);
+int32_t lps22ch_one_shot_get(const stmdev_ctx_t *ctx,
+                             lps22ch_one_shot_t *val, lps22ch_data_t *data);
+
+typedef struct
+{
+  uint32_t  period_q4;      /* learned wait between samples (1/16 ms) */
+  uint32_t  guard_ms;       /* wake-up margin before predicted sample */
+  uint32_t  guard_max_ms;
+  uint32_t  status_reads;
+  uint32_t  samples;
+  uint32_t  misses;         /* reads done before data was ready */
+  uint32_t  overruns;       /* samples lost (p_or / t_or) */
+} lps22ch_drdy_pred_t;
+void lps22ch_drdy_pred_init(lps22ch_drdy_pred_t *val, lps22ch_odr_t odr);
+int32_t lps22ch_drdy_pred_read(const stmdev_ctx_t *ctx,
+                               lps22ch_drdy_pred_t *val,
+                               lps22ch_data_t *data);
+float_t lps22ch_drdy_pred_reads_per_sample(const lps22ch_drdy_pred_t *val);
+
+typedef struct
+{
+  lps22ch_interrupt_cfg_t  interrupt_cfg;
+  lps22ch_ths_p_l_t        ths_p_l;
+  lps22ch_ths_p_h_t        ths_p_h;
+  lps22ch_if_ctrl_t        if_ctrl;
+  lps22ch_ctrl_reg1_t      ctrl_reg1;
+  lps22ch_ctrl_reg2_t      ctrl_reg2;
+  lps22ch_ctrl_reg3_t      ctrl_reg3;
+  lps22ch_fifo_ctrl_t      fifo_ctrl;
+  lps22ch_fifo_wtm_t       fifo_wtm;
+  int16_t                  ref_p;
+  int16_t                  rpds;
+} lps22ch_cfg_t;
+int32_t lps22ch_cfg_set(const stmdev_ctx_t *ctx, const lps22ch_cfg_t *val);
+int32_t lps22ch_cfg_get(const stmdev_ctx_t *ctx, lps22ch_cfg_t *val);
+
+typedef enum
+{
+  LPS22CH_INIT_ID          = 0,
+  LPS22CH_INIT_RESET       = 1,
+  LPS22CH_INIT_RESET_WAIT  = 2,
+  LPS22CH_INIT_BOOT        = 3,
+  LPS22CH_INIT_BOOT_WAIT   = 4,
+  LPS22CH_INIT_CONFIG      = 5,
+  LPS22CH_INIT_DONE        = 6,
+  LPS22CH_INIT_ERROR       = 7,
+} lps22ch_init_state_t;
+
+/** Max number of wait polls (one per pass) before an init times out **/
+#define LPS22CH_INIT_MAX_POLLS                  50U
+
+typedef struct
+{
+  const stmdev_ctx_t       *ctx;
+  const lps22ch_cfg_t      *cfg;
+  uint8_t                  boot;   /* PROPERTY_ENABLE: reload trimming */
+  lps22ch_init_state_t     state;
+  uint8_t                  polls;
+  int32_t                  ret;
+} lps22ch_init_t;
+void lps22ch_init_prepare(lps22ch_init_t *val, const stmdev_ctx_t *ctx,
+                          const lps22ch_cfg_t *cfg, uint8_t boot);
+uint8_t lps22ch_init_step(lps22ch_init_t *val, uint8_t num);
+int32_t lps22ch_init_run(lps22ch_init_t *val, uint8_t num,
+                         stmdev_mdelay_ptr mdelay);
+
+typedef struct
+{
+  uint8_t                 wtm;
+  uint8_t                 check_every;  /* verify flags every N drains */
+  uint8_t                 count;
+  uint8_t                 level;        /* FIFO_STATUS1 at last check */
+  lps22ch_fifo_status2_t  fifo_status2; /* FIFO_STATUS2 at last check */
+  uint32_t                drains;
+  uint32_t                desync;       /* checks that found ovr / data */
+} lps22ch_fifo_wtm_drain_t;
+int32_t lps22ch_fifo_wtm_drain_init(const stmdev_ctx_t *ctx,
+                                    lps22ch_fifo_wtm_drain_t *val,
+                                    uint8_t wtm, uint8_t check_every);
+int32_t lps22ch_fifo_wtm_drain(const stmdev_ctx_t *ctx,
+                               lps22ch_fifo_wtm_drain_t *val,
+                               lps22ch_fifo_record_t *buff);
+
+typedef struct
+{
+  uint32_t  seq;       /* sequence number of the next record */
+  uint32_t  batches;
+  uint32_t  gaps;      /* FIFO overruns detected */
+  uint8_t   level;     /* records known to be in FIFO */
+  uint8_t   ovr;       /* overrun seen, not yet reported */
+} lps22ch_stream_t;
+
+typedef struct
+{
+  uint32_t  first_seq; /* sequence number of the first record */
+  uint8_t   num;       /* records read */
+  uint8_t   gap;       /* 1: records lost before the first one */
+} lps22ch_stream_batch_t;
+int32_t lps22ch_stream_start(const stmdev_ctx_t *ctx, lps22ch_stream_t *val,
+                             uint8_t wtm);
+int32_t lps22ch_stream_read(const stmdev_ctx_t *ctx, lps22ch_stream_t *val,
+                            lps22ch_fifo_record_t *buff, uint8_t max,
+                            lps22ch_stream_batch_t *batch);
+
+typedef struct
+{
+  lps22ch_f_mode_t        mode;        /* trigger FIFO mode armed */
+  uint8_t                 triggered;
+  uint8_t                 pre;         /* records stored before event */
+  uint8_t                 num;         /* records collected */
+  uint32_t                timestamp;   /* host time of the event */
+  lps22ch_int_source_t    int_source;  /* INT_SOURCE at event time */
+} lps22ch_event_t;
+int32_t lps22ch_event_arm(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                          lps22ch_f_mode_t mode, lps22ch_pe_t pe);
+int32_t lps22ch_event_trigger(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                              uint32_t timestamp);
+int32_t lps22ch_event_collect(const stmdev_ctx_t *ctx, lps22ch_event_t *val,
+                              lps22ch_fifo_record_t *buff, uint8_t max);
+
+typedef enum
+{
+  LPS22CH_THS_MON_NORMAL  = 0,
+  LPS22CH_THS_MON_HIGH    = 1,
+  LPS22CH_THS_MON_LOW     = 2,
+} lps22ch_ths_mon_state_t;
+
+typedef struct
+{
+  int16_t                  ref[3];  /* REF_P for each state */
+  uint8_t                  interrupt_cfg; /* INTERRUPT_CFG image */
+  lps22ch_ths_mon_state_t  state;
+} lps22ch_ths_mon_t;
+int32_t lps22ch_ths_mon_set(const stmdev_ctx_t *ctx, lps22ch_ths_mon_t *val,
+                            float_t low_hpa, float_t high_hpa,
+                            float_t hyst_hpa);
+int32_t lps22ch_ths_mon_handle(const stmdev_ctx_t *ctx,
+                               lps22ch_ths_mon_t *val,
+                               lps22ch_int_source_t *src);
+
+typedef struct
+{
+  uint8_t                  interrupt_cfg; /* INTERRUPT_CFG image */
+  int16_t                  ref;        /* REF_P captured by autozero */
+  uint8_t                  ref_valid;
+} lps22ch_rel_press_t;
+
+typedef struct
+{
+  lps22ch_status_t         status;
+  int32_t                  rel_raw;    /* PRESS_OUT - REF_P */
+  uint32_t                 abs_raw;    /* same format of press_raw */
+  int16_t                  temp_raw;
+} lps22ch_rel_data_t;
+int32_t lps22ch_rel_press_start(const stmdev_ctx_t *ctx,
+                                lps22ch_rel_press_t *val);
+int32_t lps22ch_rel_press_get(const stmdev_ctx_t *ctx,
+                              lps22ch_rel_press_t *val,
+                              lps22ch_rel_data_t *data);
+int32_t lps22ch_rel_press_rezero(const stmdev_ctx_t *ctx,
+                                 lps22ch_rel_press_t *val);
+int32_t lps22ch_rel_press_stop(const stmdev_ctx_t *ctx,
+                               lps22ch_rel_press_t *val);
+
+/** Max samples collected per device during offset calibration **/
+#define LPS22CH_CALIB_MAX_SAMPLES               32U
+
+typedef struct
+{
+  const stmdev_ctx_t      *ctx;
+  uint32_t                press[LPS22CH_CALIB_MAX_SAMPLES];
+  uint8_t                 num;         /* samples collected */
+  uint8_t                 fifo_ctrl;   /* restored by calib_apply */
+  int16_t                 rpds_old;
+  int16_t                 rpds;
+  float_t                 mean_hpa;    /* trimmed mean */
+  float_t                 spread_hpa;  /* max - min of kept samples */
+  int32_t                 ret;
+} lps22ch_calib_t;
+void lps22ch_calib_prepare(lps22ch_calib_t *val, const stmdev_ctx_t *ctx);
+int32_t lps22ch_calib_start(lps22ch_calib_t *val, uint8_t num_dev);
+uint8_t lps22ch_calib_step(lps22ch_calib_t *val, uint8_t num_dev,
+                           uint8_t samples);
+void lps22ch_calib_compute(lps22ch_calib_t *val, uint8_t num_dev,
+                           uint8_t trim);
+int32_t lps22ch_calib_apply(lps22ch_calib_t *val, uint8_t num_dev,
+                            float_t ref_hpa);
+
+/** Registers addressable by a read plan: 00h..TEMP_OUT_H **/
+#define LPS22CH_PLAN_MAP_SIZE                   0x2DU
+#define LPS22CH_PLAN_MAX_SEG                    8U
+#define LPS22CH_PLAN_REG(reg)                   ((uint64_t)1U << (reg))
+
+typedef struct
+{
+  uint16_t  xfer_cost;  /* fixed cost of one transaction */
+  uint16_t  byte_cost;  /* cost of one data byte */
+} lps22ch_bus_cost_t;
+
+typedef struct
+{
+  uint8_t   reg;
+  uint8_t   len;
+} lps22ch_plan_seg_t;
+
+typedef struct
+{
+  lps22ch_plan_seg_t  seg[LPS22CH_PLAN_MAX_SEG];
+  uint8_t             num;
+  uint32_t            cost;
+} lps22ch_plan_t;
+int32_t lps22ch_plan_build(const lps22ch_bus_cost_t *cost, uint64_t regs,
+                           lps22ch_plan_t *val);
+int32_t lps22ch_plan_exec(const stmdev_ctx_t *ctx, const lps22ch_plan_t *val,
+                          uint8_t *image);
+
+/**
+  * Memory barrier used by the lock-free sample cache and the broadcast
+  * ring. A default is provided for GCC-compatible compilers and for C11
+  * atomics; on other toolchains define it to the barrier of your
+  * platform, otherwise the cache and the ring are not built.
+  */
+#ifndef LPS22CH_MEM_BARRIER
+#if defined(__GNUC__)
+#define LPS22CH_MEM_BARRIER()  __sync_synchronize()
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+      !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define LPS22CH_MEM_BARRIER()  atomic_thread_fence(memory_order_seq_cst)
+#endif /* __GNUC__ */
+#endif /* LPS22CH_MEM_BARRIER */
+
+#ifdef LPS22CH_MEM_BARRIER
+
+typedef struct
+{
+  lps22ch_data_t  data;
+  float_t         hpa;
+  float_t         deg_c;
+  uint32_t        timestamp;
+} lps22ch_sample_t;
+
+typedef struct
+{
+  volatile uint32_t  seq;      /* odd while an update is in progress */
+  lps22ch_sample_t   sample;
+} lps22ch_latest_t;
+void lps22ch_latest_init(lps22ch_latest_t *val);
+void lps22ch_latest_publish(lps22ch_latest_t *val, const lps22ch_data_t *data,
+                            uint32_t timestamp);
+int32_t lps22ch_latest_read(const lps22ch_latest_t *val,
+                            lps22ch_sample_t *sample);
+
+/** Broadcast ring capacity in records (power of 2) **/
+#ifndef LPS22CH_RING_SIZE
+#define LPS22CH_RING_SIZE                       1024U
+#endif /* LPS22CH_RING_SIZE */
+
+typedef struct
+{
+  volatile uint32_t      reserve;  /* records being written up to here */
+  volatile uint32_t      head;     /* records published up to here */
+  lps22ch_fifo_record_t  rec[LPS22CH_RING_SIZE];
+} lps22ch_ring_t;
+
+typedef struct
+{
+  uint32_t               tail;     /* next record to read */
+  uint32_t               lost;     /* records overwritten before read */
+} lps22ch_ring_cursor_t;
+void lps22ch_ring_init(lps22ch_ring_t *val);
+void lps22ch_ring_publish(lps22ch_ring_t *val,
+                          const lps22ch_fifo_record_t *rec, uint32_t num);
+int32_t lps22ch_ring_fifo_read(const stmdev_ctx_t *ctx, lps22ch_ring_t *val,
+                               uint8_t num);
+void lps22ch_ring_cursor_init(const lps22ch_ring_t *val,
+                              lps22ch_ring_cursor_t *cur);
+uint32_t lps22ch_ring_peek(const lps22ch_ring_t *val,
+                           lps22ch_ring_cursor_t *cur,
+                           const lps22ch_fifo_record_t **rec);
+int32_t lps22ch_ring_release(const lps22ch_ring_t *val,
+                             lps22ch_ring_cursor_t *cur, uint32_t num);
+#endif /* LPS22CH_MEM_BARRIER */
+
+typedef struct
+{
+  uint8_t   reg;
+  uint8_t   write;   /* PROPERTY_ENABLE: write, PROPERTY_DISABLE: read */
+  uint16_t  len;
+  uint8_t   *buff;
+} lps22ch_xfer_t;
+void lps22ch_xfer_reg_prepare(lps22ch_xfer_t *xfer, uint8_t reg,
+                              uint8_t *buff, uint16_t len, uint8_t write);
+void lps22ch_xfer_data_prepare(lps22ch_xfer_t *xfer, uint8_t *buff);
+void lps22ch_xfer_data_decode(const lps22ch_xfer_t *xfer,
+                              lps22ch_data_t *val);
+int32_t lps22ch_xfer_fifo_prepare(lps22ch_xfer_t *xfer,
+                                  lps22ch_fifo_record_t *buff, uint8_t num);
+void lps22ch_xfer_one_shot_prepare(lps22ch_xfer_t *xfer,
+                                   lps22ch_one_shot_t *val, uint8_t *buff);
+int32_t lps22ch_xfer_exec(const stmdev_ctx_t *ctx,
+                          const lps22ch_xfer_t *xfer);
+
+typedef enum
+{
+  LPS22CH_NAPI_IRQ   = 0, /* DRDY routed, waiting for interrupt */
+  LPS22CH_NAPI_POLL  = 1, /* DRDY masked, caller must keep polling */
+} lps22ch_napi_mode_t;
+
+typedef struct
+{
+  uint8_t              ctrl_reg3;  /* cached, written without RMW */
+  lps22ch_napi_mode_t  mode;
+  uint32_t             idle_max;   /* empty polls before unmasking DRDY */
+  uint32_t             idle;
+  uint32_t             irqs;
+  uint32_t             polls;
+  uint32_t             samples;
+  uint32_t             to_poll;    /* IRQ -> polling transitions */
+  uint32_t             to_irq;     /* polling -> IRQ transitions */
+} lps22ch_napi_t;
+int32_t lps22ch_napi_init(const stmdev_ctx_t *ctx, lps22ch_napi_t *val,
+                          uint32_t idle_max);
+int32_t lps22ch_napi_irq(const stmdev_ctx_t *ctx, lps22ch_napi_t *val);
+int32_t lps22ch_napi_poll(const stmdev_ctx_t *ctx, lps22ch_napi_t *val,
+                          lps22ch_data_t *data, uint32_t *num);
+
+/**
+  * Static bindings for the DRDY fast path. Define LPS22CH_FAST_READ to a
+  * function with the stmdev_read_ptr signature and LPS22CH_FAST_CALLBACK
+  * to a function with the lps22ch_fast_cb_t signature (when compiling
+  * the driver) to remove the pointer calls from lps22ch_fast_isr.
+  */
+typedef void (*lps22ch_fast_cb_t)(void *arg, int32_t press_q12,
+                                  int16_t temp_c100);
+
+typedef struct
+{
+  stmdev_read_ptr    read_reg;
+  void               *handle;
+  lps22ch_fast_cb_t  cb;
+  void               *arg;
+} lps22ch_fast_t;
+int32_t lps22ch_fast_init(const stmdev_ctx_t *ctx, lps22ch_fast_t *val,
+                          lps22ch_fast_cb_t cb, void *arg);
+int32_t lps22ch_fast_isr(const lps22ch_fast_t *val);
+
+const lps22ch_reg_desc_t *lps22ch_reg_desc_get(uint8_t reg);
+uint8_t lps22ch_reg_access_get(uint8_t reg);
+
+typedef struct
+{
+  stmdev_ctx_t        ctx;       /* pass &ctx to the getters */
+  const stmdev_ctx_t  *bus;
+  uint64_t            valid;     /* LPS22CH_PLAN_REG() of cached regs */
+  uint8_t             image[LPS22CH_PLAN_MAP_SIZE];
+  uint32_t            reads;     /* bus read transactions */
+  uint32_t            hits;      /* reads served from image */
+} lps22ch_scope_t;
+void lps22ch_scope_begin(lps22ch_scope_t *val, const stmdev_ctx_t *ctx);
+void lps22ch_scope_end(lps22ch_scope_t *val);
+
+typedef struct
+{
+  stmdev_ctx_t        ctx;       /* pass &ctx to the setters */
+  const stmdev_ctx_t  *bus;
+  uint64_t            valid;     /* LPS22CH_PLAN_REG() of known regs */
+  uint64_t            dirty;     /* LPS22CH_PLAN_REG() of staged regs */
+  uint8_t             image[LPS22CH_PLAN_MAP_SIZE];
+  uint32_t            writes;    /* bus write transactions */
+} lps22ch_stage_t;
+void lps22ch_stage_begin(lps22ch_stage_t *val, const stmdev_ctx_t *ctx);
+int32_t lps22ch_flush(lps22ch_stage_t *val);
+
+/** Registers covered by lps22ch_cfg_t, for lps22ch_regmap_diff **/
+#define LPS22CH_REGMAP_CFG_MASK                                            \
+  (((((uint64_t)1U << 4) - 1U) << LPS22CH_INTERRUPT_CFG) |                \
+   ((((uint64_t)1U << 7) - 1U) << LPS22CH_CTRL_REG1) |                    \
+   ((((uint64_t)1U << 2) - 1U) << LPS22CH_RPDS_L))
+
+typedef struct
+{
+  uint8_t  ctrl[12];   /* INTERRUPT_CFG .. REF_P_H */
+  uint8_t  rpds[2];    /* RPDS_L .. RPDS_H */
+  uint8_t  out[9];     /* INT_SOURCE .. TEMP_OUT_H */
+} lps22ch_regmap_t;
+int32_t lps22ch_regmap_snapshot(const stmdev_ctx_t *ctx,
+                                lps22ch_regmap_t *val);
+void lps22ch_regmap_from_cfg(const lps22ch_cfg_t *cfg,
+                             lps22ch_regmap_t *val);
+uint64_t lps22ch_regmap_diff(const lps22ch_regmap_t *val,
+                             const lps22ch_regmap_t *ref, uint64_t mask);
+int32_t lps22ch_regmap_reapply(const stmdev_ctx_t *ctx,
+                               const lps22ch_regmap_t *val, uint64_t diff);
+
+typedef struct
+{
+  lps22ch_cfg_t  cfg;        /* last known configuration */
+  uint32_t       checks;
+  uint32_t       reboots;
+} lps22ch_recover_t;
+void lps22ch_recover_init(lps22ch_recover_t *val, const lps22ch_cfg_t *cfg);
+int32_t lps22ch_recover_check(const stmdev_ctx_t *ctx,
+                              lps22ch_recover_t *val, uint8_t *rebooted);
+int32_t lps22ch_recover_restore(const stmdev_ctx_t *ctx,
+                                lps22ch_recover_t *val,
+                                lps22ch_stream_t *stream);
+
+typedef int32_t (*lps22ch_mux_select_ptr)(void *bus, uint8_t channel);
+typedef void *(*lps22ch_handle_get_ptr)(void *bus, uint8_t channel,
+                                        uint8_t address);
+
+typedef struct
+{
+  stmdev_ctx_t            ctx;           /* template: bus functions */
+  void                    *bus;
+  lps22ch_mux_select_ptr  mux_select;    /* NULL: no mux on this bus */
+  lps22ch_handle_get_ptr  handle_get;    /* handle of one candidate */
+  uint8_t                 mux_channels;
+} lps22ch_bus_t;
+
+typedef struct
+{
+  stmdev_ctx_t  ctx;                     /* ready-made context */
+  uint8_t       bus;
+  uint8_t       channel;
+  uint8_t       address;
+} lps22ch_found_t;
+int32_t lps22ch_discover_bus(const lps22ch_bus_t *bus, uint8_t bus_id,
+                             lps22ch_found_t *found, uint8_t max,
+                             uint8_t *num);
+int32_t lps22ch_discover(const lps22ch_bus_t *bus, uint8_t num_bus,
+                         lps22ch_found_t *found, uint8_t max,
+                         uint8_t *num);
+
 /**
   * @}
   *